@@ -10,6 +10,7 @@
 #include <netser/remainder.hpp>
 #include <meta/tlist.hpp>
 #include <netser/utility.hpp>
+#include <cstring>
 #include <type_traits>
 
 
@@ -32,9 +33,43 @@ namespace netser
     };
 #endif
 
+    namespace detail
+    {
+        // copy_bytes
+        // memcpy of static size that the compiler is allowed to turn into a single load or store.
+        template <size_t Size>
+        NETSER_FORCE_INLINE void copy_bytes(void *dest, const void *src)
+        {
+#ifdef __GNUC__
+            __builtin_memcpy(dest, src, Size);
+#else
+            std::memcpy(dest, src, Size);
+#endif
+        }
+    } // namespace detail
+
+    // dereference_mode
+    // reinterpret: aligned accesses dereference a reinterpret_cast'ed pointer (needs -fno-strict-aliasing to be well defined)
+    // copy:        all accesses are copied through a fixed-size memcpy on a pointer with known alignment, which compiles into the same
+    //              single load or store without violating strict aliasing.
+    // Define NETSER_COPY_DEREFERENCE to make copy the default for all generated accesses.
+    enum class dereference_mode
+    {
+        reinterpret,
+        copy
+    };
+
+#ifdef NETSER_COPY_DEREFERENCE
+    constexpr dereference_mode default_dereference_mode = dereference_mode::copy;
+#else
+    constexpr dereference_mode default_dereference_mode = dereference_mode::reinterpret;
+#endif
+
     template <int Begin, int End>
     struct bounded
     {
+        static constexpr bool has_upper_bound = true;
+
         static constexpr bool contains(int begin, int end)
         {
             return begin >= Begin && end < End;
@@ -47,6 +82,8 @@ namespace netser
     template <int Begin>
     struct lower_bounded
     {
+        static constexpr bool has_upper_bound = false;
+
         static constexpr bool contains(int begin, int end)
         {
             (void)end;
@@ -153,6 +190,8 @@ namespace netser
             return get_offset<0>();
         }
 
+        // dereference
+        // Note: The returned reference aliases the buffer, prefer load/store in generated code.
         template <typename T, int Offset = 0>
         T &dereference() const
         {
@@ -167,6 +206,90 @@ namespace netser
             return *reinterpret_cast<T *>(reinterpret_cast<copy_constness_t<Type, char> *>(get_offset<Offset>()));
         }
 
+        // load
+        // Reads a T at the given Offset. If the static alignment at Offset does not meet the natural alignment of T or Mode is copy, the
+        // value is copied out, which compiles into a single load on platforms that support it.
+        template <typename T, int Offset = 0, dereference_mode Mode = default_dereference_mode>
+        T load() const
+        {
+            if constexpr (Mode == dereference_mode::reinterpret && get_access_alignment(Offset) % alignof(T) == 0)
+            {
+                return dereference<const T, Offset>();
+            }
+            else
+            {
+                static_assert(offset_range::contains(Offset, Offset + int(sizeof(T))),
+                              "Pointer range does not contain the loaded type at given Offset.");
+#ifdef NETSER_DEREFERENCE_LOGGING
+                if (logger_)
+                {
+                    logger_->log(reinterpret_cast<uintptr_t>(get_offset<0>()), Offset, typeid(T).name(), sizeof(T),
+                                 get_access_alignment(Offset));
+                }
+#endif
+                T value;
+                detail::copy_bytes<sizeof(T)>(&value, get_offset<Offset>());
+                return value;
+            }
+        }
+
+        // store
+        // Writes a T at the given Offset, see load.
+        template <typename T, int Offset = 0, dereference_mode Mode = default_dereference_mode>
+        void store(T value) const
+        {
+            if constexpr (Mode == dereference_mode::reinterpret && get_access_alignment(Offset) % alignof(T) == 0)
+            {
+                dereference<T, Offset>() = value;
+            }
+            else
+            {
+                static_assert(offset_range::contains(Offset, Offset + int(sizeof(T))),
+                              "Pointer range does not contain the stored type at given Offset.");
+#ifdef NETSER_DEREFERENCE_LOGGING
+                if (logger_)
+                {
+                    logger_->log(reinterpret_cast<uintptr_t>(get_offset<0>()), Offset, typeid(T).name(), sizeof(T),
+                                 get_access_alignment(Offset));
+                }
+#endif
+                detail::copy_bytes<sizeof(T)>(get_offset<Offset>(), &value);
+            }
+        }
+
+        // byte_range
+        // Returns the pointer at Offset for a bulk access of Size bytes (checked against the offset range, logged as one access).
+        template <size_t Size, int Offset = 0>
+        copy_constness_t<Type, unsigned char> *byte_range() const
+        {
+            static_assert(offset_range::contains(Offset, Offset + int(Size)), "Pointer range does not contain the bytes at given Offset.");
+#ifdef NETSER_DEREFERENCE_LOGGING
+            if (logger_)
+            {
+                logger_->log(reinterpret_cast<uintptr_t>(get_offset<0>()), Offset, typeid(unsigned char[Size]).name(), Size,
+                             get_access_alignment(Offset));
+            }
+#endif
+            return reinterpret_cast<copy_constness_t<Type, unsigned char> *>(get_offset<Offset>());
+        }
+
+        // load_bytes
+        // Copies Size bytes starting at Offset to dest. The source carries the static alignment at Offset, so the compiler can expand
+        // the copy into accesses as wide as that alignment allows.
+        template <size_t Size, int Offset = 0>
+        void load_bytes(void *dest) const
+        {
+            detail::copy_bytes<Size>(dest, byte_range<Size, Offset>());
+        }
+
+        // store_bytes
+        // Copies Size bytes from src to Offset, see load_bytes.
+        template <size_t Size, int Offset = 0>
+        void store_bytes(const void *src) const
+        {
+            detail::copy_bytes<Size>(byte_range<Size, Offset>(), src);
+        }
+
         // static_offset_bits
         // Convenience checked offset.
         // Offset this pointer by a static amount of bits. RelativeOffset must be a multiple of 8 bits.
@@ -197,10 +320,12 @@ namespace netser
 
         // stride
         // Offset this pointer by a dynamic amount of static strides in bytes.
+        // Every multiple of the stride keeps the residue modulo gcd(Alignment, StrideBytes), so that much of the residue class is kept.
         template <size_t StrideBytes>
         auto stride(size_t index) const
         {
-            return aligned_ptr<Type, gcd(get_access_alignment(0), power2_alignment_of(StrideBytes))>(
+            constexpr size_t stride_alignment = gcd(Alignment, power2_alignment_of(StrideBytes));
+            return aligned_ptr<Type, stride_alignment, Defect % stride_alignment>(
                 reinterpret_cast<Type *>(reinterpret_cast<copy_constness_t<Type, char> *>(ptr_) + StrideBytes * index)
 #ifdef NETSER_DEREFERENCE_LOGGING
                     ,
@@ -209,6 +334,45 @@ namespace netser
             );
         }
 
+        // weaken
+        // The same pointer with only its residue modulo WeakAlignment known, f.e. to join pointers of different residue classes.
+        template <size_t WeakAlignment>
+        auto weaken() const
+        {
+            static_assert(Alignment % WeakAlignment == 0, "Can only weaken to a divisor of the alignment.");
+            return aligned_ptr<Type, WeakAlignment, Defect % WeakAlignment>(ptr_
+#ifdef NETSER_DEREFERENCE_LOGGING
+                                                                            ,
+                                                                            logger_
+#endif
+            );
+        }
+
+        // stride_period
+        // Number of strides after which the residue class of a strided pointer repeats.
+        template <size_t StrideBytes>
+        static constexpr size_t stride_period()
+        {
+            return Alignment / gcd(Alignment, power2_alignment_of(StrideBytes));
+        }
+
+        // periodic_stride
+        // Offset this pointer by (Phase + stride_period * period_index) strides. Since stride_period strides are a multiple of
+        // Alignment, the result keeps the full residue class of stride number Phase.
+        template <size_t StrideBytes, size_t Phase>
+        auto periodic_stride(size_t period_index) const
+        {
+            constexpr size_t period_bytes = StrideBytes * stride_period<StrideBytes>();
+            return aligned_ptr<Type, Alignment, residue::offset_remainder(int(Phase * StrideBytes))>(
+                reinterpret_cast<Type *>(reinterpret_cast<copy_constness_t<Type, char> *>(ptr_) + Phase * StrideBytes
+                                         + period_bytes * period_index)
+#ifdef NETSER_DEREFERENCE_LOGGING
+                    ,
+                logger_
+#endif
+            );
+        }
+
         // stride_offset
         template <size_t StrideBytes, int RelativeOffsetBytes>
         auto stride_offset(size_t index)
@@ -232,6 +396,14 @@ namespace netser
 #endif
     };
 
+    // common_alignment_v< PtrA, PtrB >
+    // Largest alignment modulo which both pointers have the same residue (see aligned_ptr::weaken).
+    template <typename PtrA, typename PtrB>
+    constexpr size_t common_alignment_v
+        = gcd(gcd(PtrA::get_max_alignment(), PtrB::get_max_alignment()),
+              PtrA::get_pointer_defect() > PtrB::get_pointer_defect() ? PtrA::get_pointer_defect() - PtrB::get_pointer_defect()
+                                                                      : PtrB::get_pointer_defect() - PtrA::get_pointer_defect());
+
     template <size_t Alignment, size_t Defect = 0, int Offset = 0, typename OffsetRange = lower_bounded<0>, typename Arg>
     auto make_aligned_ptr(Arg *arg
 #ifdef NETSER_DEREFERENCE_LOGGING
@@ -247,6 +419,66 @@ namespace netser
 #endif
     }
 
+    namespace detail
+    {
+
+        // dispatch_defect
+        // if-chain over all residues, which the compiler turns into a jump table with every call inlined.
+        template <size_t Alignment, size_t Defect, typename OffsetRange, typename Type, typename F>
+        NETSER_FORCE_INLINE decltype(auto) dispatch_defect(Type *ptr, size_t defect, F &f
+#ifdef NETSER_DEREFERENCE_LOGGING
+                                                           ,
+                                                           dereference_logger *logger
+#endif
+        )
+        {
+#ifdef NETSER_DEREFERENCE_LOGGING
+            aligned_ptr<Type, Alignment, Defect, OffsetRange> aptr(ptr, logger);
+#else
+            aligned_ptr<Type, Alignment, Defect, OffsetRange> aptr(ptr);
+#endif
+            if constexpr (Defect + 1 == Alignment)
+            {
+                return f(aptr);
+            }
+            else
+            {
+                if (defect == Defect)
+                {
+                    return f(aptr);
+                }
+                return dispatch_defect<Alignment, Defect + 1, OffsetRange>(ptr, defect, f
+#ifdef NETSER_DEREFERENCE_LOGGING
+                                                              ,
+                                                              logger
+#endif
+                );
+            }
+        }
+
+    } // namespace detail
+
+    // dispatch_aligned< MaxAlignment >( ptr, f )
+    // Calls f with ptr as aligned_ptr<Type, MaxAlignment, ptr % MaxAlignment>, so buffers whose alignment is only known at runtime still
+    // get the access plan of their residue. f must return the same type for every residue.
+    template <size_t MaxAlignment, typename OffsetRange = lower_bounded<0>, typename Type, typename F>
+    decltype(auto) dispatch_aligned(Type *ptr, F &&f
+#ifdef NETSER_DEREFERENCE_LOGGING
+                                    ,
+                                    dereference_logger *logger = nullptr
+#endif
+    )
+    {
+        static_assert(MaxAlignment > 0 && power2_alignment_of(MaxAlignment) == MaxAlignment, "Alignment must be a power of two.");
+
+        return detail::dispatch_defect<MaxAlignment, 0, OffsetRange>(ptr, reinterpret_cast<uintptr_t>(ptr) % MaxAlignment, f
+#ifdef NETSER_DEREFERENCE_LOGGING
+                                                        ,
+                                                        logger
+#endif
+        );
+    }
+
     template <int Offset, size_t Alignment, size_t Defect, typename OffsetRange, typename Type>
     auto offset(aligned_ptr<Type, Alignment, Defect, OffsetRange> ptr)
     {
@@ -12,6 +12,10 @@
 #include <netser/read.hpp>
 #include <netser/write.hpp>
 #include <netser/field.hpp>
+#include <netser/swap_kernels.hpp>
+#include <array>
+#include <cstddef>
+#include <iterator>
 #include <type_traits>
 
 namespace netser
@@ -61,6 +65,70 @@ namespace netser
             }
         };
 
+        // is_word_element
+        // true iff T is an integer of Bytes bytes that can be copied bitwise from/to a net integer of the same size.
+        template <typename T, size_t Bytes, typename U = std::remove_cv_t<T>>
+        constexpr bool is_word_element_v = sizeof(U) == Bytes && ((std::is_integral_v<U> && !std::is_same_v<U, bool>)
+                                                                  || (Bytes == 1 && std::is_same_v<U, std::byte>));
+
+        // contiguous_storage
+        // Host storage that holds Count elements back to back (C arrays and std::array).
+        template <typename T>
+        struct contiguous_storage
+        {
+            static constexpr bool value = false;
+        };
+
+        template <typename Element, size_t Count>
+        struct contiguous_storage<Element[Count]>
+        {
+            static constexpr bool value = true;
+            using element = Element;
+            static constexpr size_t count = Count;
+        };
+
+        template <typename Element, size_t Count>
+        struct contiguous_storage<std::array<Element, Count>>
+        {
+            static constexpr bool value = true;
+            using element = Element;
+            static constexpr size_t count = Count;
+        };
+
+        enum class array_copy
+        {
+            elementwise, // one integer access per element
+            bytes,       // plain copy, net and host byte order match
+            swapped      // byte swapping copy
+        };
+
+        template <typename Field, size_t Size, typename Host, typename Storage = std::remove_cv_t<std::remove_reference_t<Host>>>
+        constexpr array_copy select_array_copy()
+        {
+            if constexpr (is_integer_v<Field> && contiguous_storage<Storage>::value)
+            {
+                constexpr size_t bytes = Field::size / 8;
+                if constexpr (Field::size % 8 == 0 && is_word_element_v<typename contiguous_storage<Storage>::element, bytes>
+                              && contiguous_storage<Storage>::count >= Size)
+                {
+                    if constexpr (bytes == 1)
+                        return array_copy::bytes;
+                    else if constexpr (native_byte_order<bytes>::known)
+                        return native_byte_order<bytes>::value == Field::endianess ? array_copy::bytes : array_copy::swapped;
+                    else
+                        return array_copy::elementwise;
+                }
+                else
+                {
+                    return array_copy::elementwise;
+                }
+            }
+            else
+            {
+                return array_copy::elementwise;
+            }
+        }
+
     } // namespace detail
 
     // array_layout
@@ -93,8 +161,9 @@ namespace netser
             }
         };
 
-        // Fixme: Add a fast path for byte arrays... (but how to validate the destination (mapping) pointer is aligned for bigger accesses?
-        // hrm...)
+        // Integer arrays mapped onto contiguous host storage are copied in one go, byte swapped by the kernels in swap_kernels.hpp if the
+        // byte orders differ. The host side alignment is unknown, but the net side is described by the aligned_ptr, which lets the copy
+        // use the widest accesses the buffer alignment allows.
         template <typename ZipIterator>
         static NETSER_FORCE_INLINE auto read_span(ZipIterator it)
         {
@@ -105,6 +174,19 @@ namespace netser
             {
                 return detail::unroll<0, Size, Field>::template read(it);
             }
+            else if constexpr (detail::select_array_copy<Field, Size, decltype(*it.mapping())>() == detail::array_copy::bytes)
+            {
+                it.layout().get().template load_bytes<size / 8, offset / 8>(std::data(*it.mapping()));
+                return ++it;
+            }
+            else if constexpr (detail::select_array_copy<Field, Size, decltype(*it.mapping())>() == detail::array_copy::swapped)
+            {
+                using element = typename Field::stage_type;
+                using ptr_type = typename ZipIterator::layout_iterator::pointer_type::template static_offset_t<offset / 8>;
+                detail::swap_copy<element, Size, ptr_type::get_max_alignment(), ptr_type::get_pointer_defect(), true>(
+                    reinterpret_cast<unsigned char *>(std::data(*it.mapping())), it.layout().get().template byte_range<size / 8, offset / 8>());
+                return ++it;
+            }
             else
             {
                 for (size_t i = 0; i < Size; ++i)
@@ -129,6 +211,19 @@ namespace netser
             {
                 return detail::unroll<0, Size, Field>::template write(it);
             }
+            else if constexpr (detail::select_array_copy<Field, Size, decltype(*it.mapping())>() == detail::array_copy::bytes)
+            {
+                it.layout().get().template store_bytes<size / 8, offset / 8>(std::data(*it.mapping()));
+                return ++it;
+            }
+            else if constexpr (detail::select_array_copy<Field, Size, decltype(*it.mapping())>() == detail::array_copy::swapped)
+            {
+                using element = typename Field::stage_type;
+                using ptr_type = typename ZipIterator::layout_iterator::pointer_type::template static_offset_t<offset / 8>;
+                detail::swap_copy<element, Size, ptr_type::get_max_alignment(), ptr_type::get_pointer_defect(), false>(
+                    it.layout().get().template byte_range<size / 8, offset / 8>(), reinterpret_cast<const unsigned char *>(std::data(*it.mapping())));
+                return ++it;
+            }
             else
             {
                 for (size_t i = 0; i < Size; ++i)
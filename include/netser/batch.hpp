@@ -0,0 +1,113 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_BATCH_HPP__
+#define NETSER_BATCH_HPP__
+
+#include <netser/read.hpp>
+#include <netser/write.hpp>
+#include <algorithm>
+#include <span>
+#include <utility>
+
+// Batched reads and writes of one layout over many packets.
+// The packets are processed in groups of batch_unroll with the fully inlined plan of each packet side by side, so the compiler sees
+// independent accesses of several packets at once and can interleave or vectorize them.
+namespace netser
+{
+
+    constexpr size_t batch_unroll = 4;
+
+    namespace detail
+    {
+
+        // get_ptr(i) returns the aligned_ptr of packet i, get_host(i) the mapping argument of packet i.
+        template <typename Layout, typename Mapping, typename GetPtr, typename GetHost, size_t... Index>
+        NETSER_FORCE_INLINE void read_batch_group(GetPtr &&get_ptr, GetHost &&get_host, size_t base, std::index_sequence<Index...>)
+        {
+            (read_inline<Layout, Mapping>(get_ptr(base + Index), get_host(base + Index)), ...);
+        }
+
+        template <typename Layout, typename Mapping, typename GetPtr, typename GetHost, size_t... Index>
+        NETSER_FORCE_INLINE void write_batch_group(GetPtr &&get_ptr, GetHost &&get_host, size_t base, std::index_sequence<Index...>)
+        {
+            (write_inline<Layout, Mapping>(get_ptr(base + Index), get_host(base + Index)), ...);
+        }
+
+        template <typename Layout, typename Mapping, typename GetPtr, typename GetHost>
+        NETSER_FORCE_INLINE size_t read_batch_impl(GetPtr &&get_ptr, GetHost &&get_host, size_t count)
+        {
+            size_t i = 0;
+            for (; i + batch_unroll <= count; i += batch_unroll)
+            {
+                read_batch_group<Layout, Mapping>(get_ptr, get_host, i, std::make_index_sequence<batch_unroll>());
+            }
+            for (; i < count; ++i)
+            {
+                read_inline<Layout, Mapping>(get_ptr(i), get_host(i));
+            }
+            return count;
+        }
+
+        template <typename Layout, typename Mapping, typename GetPtr, typename GetHost>
+        NETSER_FORCE_INLINE size_t write_batch_impl(GetPtr &&get_ptr, GetHost &&get_host, size_t count)
+        {
+            size_t i = 0;
+            for (; i + batch_unroll <= count; i += batch_unroll)
+            {
+                write_batch_group<Layout, Mapping>(get_ptr, get_host, i, std::make_index_sequence<batch_unroll>());
+            }
+            for (; i < count; ++i)
+            {
+                write_inline<Layout, Mapping>(get_ptr(i), get_host(i));
+            }
+            return count;
+        }
+
+    } // namespace detail
+
+    // read_batch< Layout, Mapping >( sources : span<aligned_ptr<>>, dest : span<Dest> )
+    // Reads one packet per buffer into the host object of the same index. Returns the number of packets read
+    // (the smaller of both sizes).
+    template <typename Layout, typename Mapping, typename AlignedPtr, typename Dest>
+    size_t read_batch(std::span<const AlignedPtr> sources, std::span<Dest> dest)
+    {
+        return detail::read_batch_impl<Layout, Mapping>([&](size_t i) { return sources[i]; }, [&](size_t i) -> Dest & { return dest[i]; },
+                                                        std::min(sources.size(), dest.size()));
+    }
+
+    // read_batch< Layout, Mapping, StrideBytes >( first : aligned_ptr<>, dest : span<Dest> )
+    // Reads dest.size() packets that follow each other every StrideBytes bytes, starting at first.
+    template <typename Layout, typename Mapping, size_t StrideBytes, typename AlignedPtr, typename Dest>
+    size_t read_batch(AlignedPtr first, std::span<Dest> dest)
+    {
+        static_assert(StrideBytes * 8 >= layout_size_v<Layout>, "Stride is smaller than the layout.");
+        return detail::read_batch_impl<Layout, Mapping>([&](size_t i) { return first.template stride<StrideBytes>(i); },
+                                                        [&](size_t i) -> Dest & { return dest[i]; }, dest.size());
+    }
+
+    // write_batch< Layout, Mapping >( dests : span<aligned_ptr<>>, src : span<Src> )
+    // Writes the host object of each index into the buffer of the same index. Returns the number of packets written
+    // (the smaller of both sizes).
+    template <typename Layout, typename Mapping, typename AlignedPtr, typename Src>
+    size_t write_batch(std::span<const AlignedPtr> dests, std::span<Src> src)
+    {
+        return detail::write_batch_impl<Layout, Mapping>([&](size_t i) { return dests[i]; }, [&](size_t i) -> Src & { return src[i]; },
+                                                         std::min(dests.size(), src.size()));
+    }
+
+    // write_batch< Layout, Mapping, StrideBytes >( first : aligned_ptr<>, src : span<Src> )
+    // Writes src.size() packets that follow each other every StrideBytes bytes, starting at first.
+    template <typename Layout, typename Mapping, size_t StrideBytes, typename AlignedPtr, typename Src>
+    size_t write_batch(AlignedPtr first, std::span<Src> src)
+    {
+        static_assert(StrideBytes * 8 >= layout_size_v<Layout>, "Stride is smaller than the layout.");
+        return detail::write_batch_impl<Layout, Mapping>([&](size_t i) { return first.template stride<StrideBytes>(i); },
+                                                         [&](size_t i) -> Src & { return src[i]; }, src.size());
+    }
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,157 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_CHECKED_HPP__
+#define NETSER_CHECKED_HPP__
+
+#include <netser/aligned_ptr.hpp>
+#include <netser/field.hpp>
+#include <netser/layout.hpp>
+#include <netser/zipped.hpp>
+#include <cstddef>
+#include <span>
+#include <version>
+
+#if defined(__cpp_lib_expected)
+#include <expected>
+#endif
+
+// Bounds checked entry points for packets that arrive as (pointer, length).
+// The static layout size is compared against the length once, then the unchecked plan runs. The plan works on a pointer whose offset
+// range ends at the layout size, so it never generates accesses past the checked bytes either.
+namespace netser
+{
+
+    enum class span_error
+    {
+        too_short // the span is smaller than the layout
+    };
+
+#if defined(__cpp_lib_expected)
+    // span_result
+    // Number of bytes read or written, or the reason nothing was.
+    using span_result = std::expected<size_t, span_error>;
+#else
+    // span_result
+    // Number of bytes read or written, or the reason nothing was (subset of std::expected<size_t, span_error>).
+    class span_result
+    {
+      public:
+        constexpr span_result(size_t bytes) : value_(bytes), has_value_(true)
+        {
+        }
+
+        constexpr span_result(span_error error) : error_(error), has_value_(false)
+        {
+        }
+
+        constexpr bool has_value() const
+        {
+            return has_value_;
+        }
+
+        constexpr explicit operator bool() const
+        {
+            return has_value_;
+        }
+
+        constexpr size_t value() const
+        {
+            return value_;
+        }
+
+        constexpr size_t operator*() const
+        {
+            return value_;
+        }
+
+        constexpr span_error error() const
+        {
+            return error_;
+        }
+
+      private:
+        size_t value_ = 0;
+        span_error error_ = span_error::too_short;
+        bool has_value_;
+    };
+#endif
+
+    namespace detail
+    {
+
+        constexpr span_result span_failure(span_error error)
+        {
+#if defined(__cpp_lib_expected)
+            return std::unexpected(error);
+#else
+            return span_result(error);
+#endif
+        }
+
+        // span_alignment
+        // MaxAlignment of read( span ) and write( span ), enough for every platform access.
+        constexpr size_t span_alignment = staging_alignment;
+
+    } // namespace detail
+
+    // read_checked< Zipped, MaxAlignment >( source : span<const byte>, dest : Dest& )
+    // Reads dest from the start of source if source holds the whole layout. With MaxAlignment > 1 the plan is chosen at runtime by the
+    // residue of source.data() (see dispatch_aligned).
+    template <concepts::Zipped Zipped, size_t MaxAlignment = 1, typename Dest>
+    span_result read_checked(std::span<const std::byte> source, Dest &dest)
+    {
+        static_assert(!layout_is_dynamic_v<typename Zipped::layout>, "Checked reads need a layout of static size.");
+        static_assert(layout_size_v<typename Zipped::layout> % 8 == 0, "Layout must span whole bytes.");
+        constexpr size_t bytes = layout_size_v<typename Zipped::layout> / 8;
+
+        if (source.size() < bytes)
+        {
+            return detail::span_failure(span_error::too_short);
+        }
+
+        dispatch_aligned<MaxAlignment, bounded<0, int(bytes) + 1>>(source.data(),
+                                                                    [&](auto ptr) { read_zipped_inline<Zipped>(ptr, dest); });
+        return bytes;
+    }
+
+    // write_checked< Zipped, MaxAlignment >( dest : span<byte>, source : const Src& )
+    // Writes source to the start of dest if dest can hold the whole layout, see read_checked.
+    template <concepts::Zipped Zipped, size_t MaxAlignment = 1, typename Src>
+    span_result write_checked(std::span<std::byte> dest, const Src &source)
+    {
+        static_assert(!layout_is_dynamic_v<typename Zipped::layout>, "Checked writes need a layout of static size.");
+        static_assert(layout_size_v<typename Zipped::layout> % 8 == 0, "Layout must span whole bytes.");
+        constexpr size_t bytes = layout_size_v<typename Zipped::layout> / 8;
+
+        if (dest.size() < bytes)
+        {
+            return detail::span_failure(span_error::too_short);
+        }
+
+        dispatch_aligned<MaxAlignment, bounded<0, int(bytes) + 1>>(dest.data(),
+                                                                    [&](auto ptr) { write_zipped_inline<Zipped>(ptr, source); });
+        return bytes;
+    }
+
+    // read( source : span<const byte>, dest : Dest& )
+    // read_checked with the default zipped layout of Dest, the plan is chosen by the runtime alignment of source.data().
+    template <typename Dest>
+    span_result read(std::span<const std::byte> source, Dest &dest)
+    {
+        return read_checked<default_zipped_t<Dest &>, detail::span_alignment>(source, dest);
+    }
+
+    // write( dest : span<byte>, source : const Src& )
+    // write_checked with the default zipped layout of Src, the plan is chosen by the runtime alignment of dest.data().
+    template <typename Src>
+    span_result write(std::span<std::byte> dest, const Src &source)
+    {
+        return write_checked<default_zipped_t<const Src &>, detail::span_alignment>(dest, source);
+    }
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,430 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_CHECKSUM_HPP__
+#define NETSER_CHECKSUM_HPP__
+
+#include <netser/field.hpp>
+#include <netser/integer.hpp>
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/write.hpp>
+#include <netser/zip_iterator.hpp>
+#include <netser/zipped.hpp>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+#if defined(__SSE4_2__) && defined(__x86_64__)
+#include <nmmintrin.h>
+#elif defined(__ARM_FEATURE_CRC32) && defined(__aarch64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#include <arm_acle.h>
+#endif
+
+// Checksums that are computed while a packet is read or written.
+// One leaf of the layout is a checksum_field, the checksum covers all other bytes of the layout:
+//
+//     using ipv4_zipped = zipped<..., checksum_field<internet_checksum, net_uint16>, mem<&ipv4_header::checksum>, ...>;
+//
+//     write_checksummed<ipv4_zipped>(make_aligned_ptr<4>(packet), header);        // fills in the checksum
+//     bool valid = read_checksummed<ipv4_zipped>(make_aligned_ptr<4>(packet), header);
+//
+// Integer spans are added to the checksum from the words that their accesses load or store (see detail::observe_word), so the packet
+// is walked once and not read a second time for the checksum. Only leaves that are not integers (arrays, skipped bytes) are summed
+// from memory behind their accesses.
+namespace netser
+{
+
+    // internet_checksum
+    // RFC 1071 ones' complement sum of 16 bit words (IPv4, ICMP, UDP, TCP).
+    class internet_checksum
+    {
+      public:
+        using value_type = std::uint16_t;
+
+        // update( bytes, size, offset )
+        // Adds size bytes that start at byte offset of the checksummed data. The bytes are summed as 32 bit big endian words and folded,
+        // a sum that starts at an odd offset is byte swapped into its lanes (RFC 1071, byte order independence).
+        constexpr void update(const unsigned char *bytes, size_t size, size_t offset)
+        {
+            std::uint64_t sum = 0;
+            size_t i = 0;
+            for (; i + 4 <= size; i += 4)
+            {
+                sum += (std::uint32_t(bytes[i]) << 24) | (std::uint32_t(bytes[i + 1]) << 16) | (std::uint32_t(bytes[i + 2]) << 8)
+                       | std::uint32_t(bytes[i + 3]);
+            }
+            if (i + 2 <= size)
+            {
+                sum += (std::uint32_t(bytes[i]) << 8) | std::uint32_t(bytes[i + 1]);
+                i += 2;
+            }
+            if (i < size)
+            {
+                sum += std::uint32_t(bytes[i]) << 8;
+            }
+
+            add(fold(sum), offset);
+        }
+
+        // update_word( word, size, offset )
+        // Adds the size (<= 8) low bytes of word, in big endian order, that start at byte offset of the checksummed data.
+        constexpr void update_word(std::uint64_t word, size_t size, size_t offset)
+        {
+            add(fold(size % 2 == 0 ? word : word << 8), offset);
+        }
+
+        constexpr value_type finish() const
+        {
+            return value_type(~fold(sum_));
+        }
+
+      private:
+        // add
+        // Adds a folded sum that starts at byte offset.
+        constexpr void add(std::uint64_t sum, size_t offset)
+        {
+            sum_ += (offset % 2 == 0) ? sum : ((sum & 0xff) << 8) | (sum >> 8);
+        }
+
+        // fold
+        // Ones' complement sum of the 16 bit lanes of sum.
+        static constexpr std::uint64_t fold(std::uint64_t sum)
+        {
+            while (sum >> 16)
+            {
+                sum = (sum & 0xffff) + (sum >> 16);
+            }
+            return sum;
+        }
+
+        std::uint64_t sum_ = 0;
+    };
+
+    namespace detail
+    {
+
+        constexpr std::array<std::uint32_t, 256> make_crc32c_table()
+        {
+            std::array<std::uint32_t, 256> table{};
+            for (std::uint32_t i = 0; i < 256; ++i)
+            {
+                std::uint32_t crc = i;
+                for (int bit = 0; bit < 8; ++bit)
+                {
+                    crc = (crc & 1) ? (crc >> 1) ^ 0x82f63b78u : crc >> 1;
+                }
+                table[i] = crc;
+            }
+            return table;
+        }
+
+        inline constexpr std::array<std::uint32_t, 256> crc32c_table = make_crc32c_table();
+
+    } // namespace detail
+
+    // crc32c
+    // CRC-32C (Castagnoli, iSCSI, SCTP). Uses the crc32 instructions of SSE 4.2 or ARMv8 if the translation unit is compiled for them.
+    class crc32c
+    {
+      public:
+        using value_type = std::uint32_t;
+
+        // update( bytes, size, offset )
+        // Adds size bytes, offset is not needed for CRCs (the bytes must be added in order).
+        NETSER_FORCE_INLINE void update(const unsigned char *bytes, size_t size, size_t offset)
+        {
+            (void)offset;
+#if defined(__SSE4_2__) && defined(__x86_64__)
+            std::uint64_t crc = crc_;
+            for (; size >= 8; size -= 8, bytes += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes, 8);
+                crc = _mm_crc32_u64(crc, word);
+            }
+            crc_ = std::uint32_t(crc);
+            for (; size > 0; --size, ++bytes)
+            {
+                crc_ = _mm_crc32_u8(crc_, *bytes);
+            }
+#elif defined(__ARM_FEATURE_CRC32) && defined(__aarch64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+            for (; size >= 8; size -= 8, bytes += 8)
+            {
+                std::uint64_t word;
+                std::memcpy(&word, bytes, 8);
+                crc_ = __crc32cd(crc_, word);
+            }
+            for (; size > 0; --size, ++bytes)
+            {
+                crc_ = __crc32cb(crc_, *bytes);
+            }
+#else
+            for (; size > 0; --size, ++bytes)
+            {
+                crc_ = detail::crc32c_table[(crc_ ^ *bytes) & 0xff] ^ (crc_ >> 8);
+            }
+#endif
+        }
+
+        // update_word( word, size, offset )
+        // Adds the size (<= 8) low bytes of word in big endian order.
+        NETSER_FORCE_INLINE void update_word(std::uint64_t word, size_t size, size_t offset)
+        {
+            unsigned char bytes[8];
+            for (size_t i = 0; i < size; ++i)
+            {
+                bytes[i] = static_cast<unsigned char>(word >> (8 * (size - 1 - i)));
+            }
+            update(bytes, size, offset);
+        }
+
+        value_type finish() const
+        {
+            return ~crc_;
+        }
+
+      private:
+        std::uint32_t crc_ = 0xffffffffu;
+    };
+
+    // checksum_field
+    // Leaf that holds the checksum Algorithm over the other bytes of the layout, stored as Field. Outside of read_checksummed and
+    // write_checksummed it is read and written like Field.
+    template <typename Algorithm, typename Field>
+    struct checksum_field : public detail::simple_field_layout_mixin<checksum_field<Algorithm, Field>>
+    {
+        static_assert(Field::size % 8 == 0, "Checksum fields must span whole bytes.");
+
+        using algorithm = Algorithm;
+        using value_field = Field;
+
+        static constexpr size_t size = Field::size;
+        static constexpr size_t count = 1;
+        static constexpr size_t num_children = 0;
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto read_span(ZipIterator it)
+        {
+            constexpr size_t offset = ZipIterator::layout_iterator::get_offset();
+            static_assert(offset % 8 == 0, "Checksum fields must be aligned to byte boundaries.");
+
+            auto &&target = *it.mapping();
+            read_inline<layout<Field>, mapping_list<identity_member>>(it.layout().get().template static_offset<offset / 8>(), target);
+            return ++it;
+        }
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto write_span(ZipIterator it)
+        {
+            constexpr size_t offset = ZipIterator::layout_iterator::get_offset();
+            static_assert(offset % 8 == 0, "Checksum fields must be aligned to byte boundaries.");
+
+            const auto &target = *it.mapping();
+            write_inline<layout<Field>, mapping_list<identity_member>>(it.layout().get().template static_offset<offset / 8>(), target);
+            return ++it;
+        }
+
+        template <typename MappingIterator, typename Generator>
+        static NETSER_FORCE_INLINE void fill_random(MappingIterator it, Generator &&generator)
+        {
+            Field::fill_random(it, std::forward<Generator>(generator));
+        }
+    };
+
+    namespace detail
+    {
+
+        template <typename T>
+        constexpr bool is_checksum_field_v = false;
+
+        template <typename T>
+        constexpr bool is_integer_field_v = false;
+
+        template <bool Signed, size_t Bits, byte_order ByteOrder>
+        constexpr bool is_integer_field_v<int_<Signed, Bits, ByteOrder>> = true;
+
+        template <typename Algorithm, typename Field>
+        constexpr bool is_checksum_field_v<checksum_field<Algorithm, Field>> = true;
+
+        // find_checksum_field
+        // Placed field of the first checksum_field of the layout, void if there is none.
+        template <typename LayoutMetaIterator, bool IsEnd = meta::concepts::EmptyRange<LayoutMetaIterator>>
+        struct find_checksum_field
+        {
+            using placed = meta::dereference_t<LayoutMetaIterator>;
+            using type = std::conditional_t<is_checksum_field_v<typename placed::field>, placed,
+                                            typename find_checksum_field<meta::advance_t<LayoutMetaIterator>>::type>;
+        };
+
+        template <typename LayoutMetaIterator>
+        struct find_checksum_field<LayoutMetaIterator, true>
+        {
+            using type = void;
+        };
+
+        // checksum_bytes
+        // Adds the bytes [Begin, End) behind ptr.
+        template <size_t Begin, size_t End, typename AlignedPtr, typename Algorithm>
+        NETSER_FORCE_INLINE void checksum_bytes(AlignedPtr ptr, Algorithm &state)
+        {
+            if constexpr (End > Begin)
+            {
+                state.update(ptr.template byte_range<End - Begin, int(Begin)>(), End - Begin, Begin);
+            }
+        }
+
+        // checksum_context
+        // Root argument of a checksummed read or write, adds the words of the integer spans to the checksum.
+        template <typename Host, typename Algorithm>
+        struct checksum_context
+        {
+            Host &host;
+            Algorithm &state;
+
+            NETSER_FORCE_INLINE void observe_bytes(std::uint64_t word, size_t size, size_t offset)
+            {
+                state.update_word(word, size, offset);
+            }
+        };
+
+        // checksum_root
+        // Mapping with the children of Mapping that unwraps the checksum_context before applying Mapping.
+        template <typename Mapping>
+        struct checksum_root
+        {
+            static constexpr size_t num_children = Mapping::num_children;
+
+            template <size_t Pos>
+            using get_child = typename Mapping::template get_child<Pos>;
+
+            template <typename Host, typename Algorithm>
+            static decltype(auto) apply(checksum_context<Host, Algorithm> &context)
+            {
+                return Mapping::apply(context.host);
+            }
+        };
+
+        // checksum_zip_iterator
+        // Runs the read (or write) plan span by span. Fed is the number of leading bytes added to the checksum so far, a byte that is
+        // shared by two spans is added by the second one. Integer spans add their own words through the checksum_context, the bytes of
+        // other leaves are added from memory. The checksum field is left out of the checksum (and not written). Reads return the stored
+        // checksum.
+        template <bool Write, size_t Fed, size_t LayoutBytes, typename ZipIterator, typename Algorithm>
+        NETSER_FORCE_INLINE typename Algorithm::value_type checksum_zip_iterator(ZipIterator it, Algorithm &state)
+        {
+            if constexpr (ZipIterator::is_end)
+            {
+                checksum_bytes<Fed, LayoutBytes>(it.layout().get(), state);
+                return {};
+            }
+            else
+            {
+                using field = typename meta::dereference_t<typename ZipIterator::layout_iterator>::field;
+                constexpr size_t begin = ZipIterator::layout_iterator::get_offset();
+
+                if constexpr (is_checksum_field_v<field>)
+                {
+                    checksum_bytes<Fed, begin / 8>(it.layout().get(), state);
+                    if constexpr (Write)
+                    {
+                        return checksum_zip_iterator<Write, (begin + field::size) / 8, LayoutBytes>(++it, state);
+                    }
+                    else
+                    {
+                        typename Algorithm::value_type stored{};
+                        read_inline<layout<typename field::value_field>, mapping_list<identity_member>>(
+                            it.layout().get().template static_offset<int(begin / 8)>(), stored);
+
+                        auto &&target = *it.mapping();
+                        target = static_cast<std::remove_cvref_t<decltype(target)>>(stored);
+
+                        checksum_zip_iterator<Write, (begin + field::size) / 8, LayoutBytes>(++it, state);
+                        return stored;
+                    }
+                }
+                else
+                {
+                    auto next = [&] {
+                        if constexpr (Write)
+                            return field::write_span(it);
+                        else
+                            return field::read_span(it);
+                    }();
+
+                    using next_type = decltype(next);
+                    constexpr size_t end = next_type::is_end ? LayoutBytes * 8 : next_type::layout_iterator::get_offset();
+
+                    if constexpr (!is_integer_field_v<field>)
+                    {
+                        checksum_bytes<Fed, end / 8>(it.layout().get(), state);
+                    }
+                    return checksum_zip_iterator<Write, end / 8, LayoutBytes>(next, state);
+                }
+            }
+        }
+
+        template <typename Zipped>
+        struct checksummed_layout
+        {
+            using layout = typename Zipped::layout;
+            using placed = typename find_checksum_field<layout_enumerator_t<layout>>::type;
+
+            static_assert(!std::is_void_v<placed>, "Layout has no checksum_field.");
+            static_assert(!layout_is_dynamic_v<layout>, "Checksummed layouts must have a static size.");
+            static_assert(layout_size_v<layout> % 8 == 0, "Layout must span whole bytes.");
+
+            using algorithm = typename placed::field::algorithm;
+            using value_layout = netser::layout<typename placed::field::value_field>;
+
+            static constexpr size_t bytes = layout_size_v<layout> / 8;
+            static constexpr int checksum_offset = int(placed::offset / 8);
+        };
+
+    } // namespace detail
+
+    // write_checksummed< Zipped >( dest : aligned_ptr<>, src : const Src& )
+    // Writes src, then the checksum over all other bytes of the layout into its checksum_field. The member mapped to the checksum field
+    // is not used. Returns the checksum.
+    template <concepts::Zipped Zipped, typename AlignedPtr, typename Src>
+    auto write_checksummed(AlignedPtr ptr, const Src &src)
+    {
+        using checksummed = detail::checksummed_layout<Zipped>;
+
+        typename checksummed::algorithm state;
+        detail::checksum_context<const Src, typename checksummed::algorithm> context{src, state};
+        detail::checksum_zip_iterator<true, 0, checksummed::bytes>(
+            make_zip_iterator(make_layout_iterator<typename Zipped::layout>(ptr),
+                              make_mapping_iterator<detail::checksum_root<typename Zipped::mapping>>(context)),
+            state);
+
+        const typename checksummed::algorithm::value_type checksum = state.finish();
+        write_inline<typename checksummed::value_layout, mapping_list<identity_member>>(
+            ptr.template static_offset<checksummed::checksum_offset>(), checksum);
+        return checksum;
+    }
+
+    // read_checksummed< Zipped >( source : aligned_ptr<>, dest : Dest& )
+    // Reads dest (including the stored checksum) and returns true iff the stored checksum matches the checksum over all other bytes of
+    // the layout.
+    template <concepts::Zipped Zipped, typename AlignedPtr, typename Dest>
+    bool read_checksummed(AlignedPtr ptr, Dest &dest)
+    {
+        using checksummed = detail::checksummed_layout<Zipped>;
+
+        typename checksummed::algorithm state;
+        detail::checksum_context<Dest, typename checksummed::algorithm> context{dest, state};
+        const auto stored = detail::checksum_zip_iterator<false, 0, checksummed::bytes>(
+            make_zip_iterator(make_layout_iterator<typename Zipped::layout>(ptr),
+                              make_mapping_iterator<detail::checksum_root<typename Zipped::mapping>>(context)),
+            state);
+        return state.finish() == stored;
+    }
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,82 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_COLUMNS_HPP__
+#define NETSER_COLUMNS_HPP__
+
+#include <netser/batch.hpp>
+#include <netser/mapping.hpp>
+
+// Columnar (struct of arrays) mapping.
+// The host side is a struct of indexable columns (std::span, std::vector, C arrays, ...), one per mapped field:
+//
+//     struct ptp_columns {
+//         std::span<uint16_t> sequence_id;
+//         std::span<uint64_t> timestamp;
+//     };
+//
+//     using ptp_column_mapping = mapping_list<column<&ptp_columns::sequence_id>, column<&ptp_columns::timestamp>>;
+//     read_columns<ptp_layout, ptp_column_mapping, 64>(make_aligned_ptr<8>(capture), columns, count);
+//
+// Packet i then goes to element i of every column.
+namespace netser
+{
+
+    // column_row
+    // Mapping argument for one row of a column set.
+    template <typename Columns>
+    struct column_row
+    {
+        Columns &columns;
+        size_t index;
+    };
+
+    // column
+    // Maps a field onto element row.index of the column Columns::*ColumnPtr.
+    template <auto ColumnPtr>
+    requires(concepts::MemberPtr<ColumnPtr>)
+    struct column
+    {
+        static constexpr size_t num_children = 0;
+
+        template <typename Row>
+        static auto &apply(Row &&row)
+        {
+            return (row.columns.*ColumnPtr)[row.index];
+        }
+    };
+
+    // read_columns< Layout, ColumnMapping >( sources : span<aligned_ptr<>>, columns : Columns& )
+    // Reads one packet per buffer into row i of the columns. Returns the number of packets read.
+    template <typename Layout, typename ColumnMapping, typename AlignedPtr, typename Columns>
+    size_t read_columns(std::span<const AlignedPtr> sources, Columns &columns)
+    {
+        return detail::read_batch_impl<Layout, ColumnMapping>([&](size_t i) { return sources[i]; },
+                                                              [&](size_t i) { return column_row<Columns>{columns, i}; }, sources.size());
+    }
+
+    // read_columns< Layout, ColumnMapping, StrideBytes >( first : aligned_ptr<>, columns : Columns&, count )
+    // Reads count packets that follow each other every StrideBytes bytes into rows 0..count-1 of the columns.
+    template <typename Layout, typename ColumnMapping, size_t StrideBytes, typename AlignedPtr, typename Columns>
+    size_t read_columns(AlignedPtr first, Columns &columns, size_t count)
+    {
+        static_assert(StrideBytes * 8 >= layout_size_v<Layout>, "Stride is smaller than the layout.");
+        return detail::read_batch_impl<Layout, ColumnMapping>([&](size_t i) { return first.template stride<StrideBytes>(i); },
+                                                              [&](size_t i) { return column_row<Columns>{columns, i}; }, count);
+    }
+
+    // write_columns< Layout, ColumnMapping, StrideBytes >( first : aligned_ptr<>, columns : Columns&, count )
+    // Writes rows 0..count-1 of the columns into count packets that follow each other every StrideBytes bytes.
+    template <typename Layout, typename ColumnMapping, size_t StrideBytes, typename AlignedPtr, typename Columns>
+    size_t write_columns(AlignedPtr first, Columns &columns, size_t count)
+    {
+        static_assert(StrideBytes * 8 >= layout_size_v<Layout>, "Stride is smaller than the layout.");
+        return detail::write_batch_impl<Layout, ColumnMapping>([&](size_t i) { return first.template stride<StrideBytes>(i); },
+                                                               [&](size_t i) { return column_row<Columns>{columns, i}; }, count);
+    }
+
+} // namespace netser
+
+#endif
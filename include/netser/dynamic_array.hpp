@@ -0,0 +1,205 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_DYNAMIC_ARRAY_HPP__
+#define NETSER_DYNAMIC_ARRAY_HPP__
+
+#include <netser/field.hpp>
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/write.hpp>
+#include <netser/fill_random.hpp>
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+#include <type_traits>
+
+// Length-prefixed arrays.
+// The element count is a member of the host object, decoded by an earlier field of the same layout:
+//
+//     struct path_trace {
+//         uint16_t length;
+//         std::array<uint64_t, 16> path;
+//     };
+//
+//     using path_trace_zipped = zipped<net_uint16, mem<&path_trace::length>,
+//                                      dynamic_array<&path_trace::length, net_uint64, 16>, mem<&path_trace::path>>;
+//
+// The fields behind a dynamic_array are placed relative to a runtime offset. The pointer keeps the residue class modulo the largest
+// power of two dividing the element size, so they are still planned with static accesses (8 byte elements in an 8 aligned buffer
+// keep the full alignment).
+namespace netser
+{
+
+    namespace detail
+    {
+
+        template <typename Storage>
+        concept ResizableStorage = requires(Storage &storage, size_t count) { storage.resize(count); };
+
+        // count_host
+        // Object holding the count member: the root argument of the read or write, or the object a context like the one of
+        // read_validated fills.
+        template <typename Arg>
+        NETSER_FORCE_INLINE decltype(auto) count_host(Arg &arg)
+        {
+            if constexpr (requires { arg.host(); })
+            {
+                return arg.host();
+            }
+            else
+            {
+                return (arg);
+            }
+        }
+
+        // dynamic_count
+        // Element count of a dynamic array, read from CountMember of the object the zip iterator's mapping was started on.
+        template <auto CountMember, typename MappingIterator>
+        NETSER_FORCE_INLINE size_t dynamic_count(const MappingIterator &mapping)
+        {
+            using container_type = typename member_object_pointer_traits<CountMember>::container_type;
+            static_assert(std::is_base_of_v<container_type, std::remove_cvref_t<decltype(count_host(mapping.arg_))>>,
+                          "The count member must belong to the object that is read or written.");
+
+            return static_cast<size_t>(count_host(mapping.arg_).*CountMember);
+        }
+
+        // accept_count
+        // Reports an invalid count to the root argument if it collects errors (see read_validated), otherwise a valid count is a
+        // precondition. Returns valid.
+        template <typename Arg>
+        NETSER_FORCE_INLINE bool accept_count(Arg &arg, bool valid)
+        {
+            if constexpr (requires { arg.validate_dynamic_count(valid); })
+            {
+                arg.validate_dynamic_count(valid);
+            }
+            else
+            {
+                assert(valid && "Dynamic array count exceeds its bound.");
+            }
+            return valid;
+        }
+
+        // stored_count
+        // Number of the first element_count elements that the storage actually holds.
+        template <typename Storage>
+        NETSER_FORCE_INLINE size_t stored_count(const Storage &storage, size_t element_count)
+        {
+            return std::min(static_cast<size_t>(std::size(storage)), element_count);
+        }
+
+    } // namespace detail
+
+    // dynamic_array
+    // Array of Element whose length is given by the host member CountMember at runtime, at most MaxCount.
+    // A count above MaxCount is rejected: read_validated reports it as count_out_of_range, plain reads and writes assert it. Writes
+    // also require the storage to hold count elements. A rejected array transfers no elements and takes no space in the buffer.
+    // Note: The mapping must dereference to something indexable with a size, that holds MaxCount elements or can be resized.
+    template <auto CountMember, typename Element, size_t MaxCount>
+    requires(concepts::MemberPtr<CountMember>)
+    struct dynamic_array : public detail::simple_field_layout_mixin<dynamic_array<CountMember, Element, MaxCount>>
+    {
+        static_assert(Element::size % 8 == 0, "Unsupported Array Element Stride!");
+
+        static constexpr size_t element_bytes = Element::size / 8;
+        static constexpr size_t max_count = MaxCount;
+
+        // No static extent, the elements are skipped by transform_buffer.
+        static constexpr size_t size = 0;
+        static constexpr size_t count = 1;
+        static constexpr size_t num_children = 0;
+        static constexpr bool is_dynamic = true;
+
+        using detail::simple_field_layout_mixin<dynamic_array>::transform_buffer;
+
+        // transform_buffer
+        // Moves the buffer behind element_count elements.
+        template <typename AlignedPtrType>
+        static auto transform_buffer(AlignedPtrType ptr, size_t element_count)
+        {
+            return ptr.template stride<element_bytes>(element_count);
+        }
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto read_span(ZipIterator it)
+        {
+            constexpr size_t offset = ZipIterator::layout_iterator::get_offset();
+            static_assert(offset % 8 == 0, "Arrays must be aligned to byte boundaries.");
+
+            size_t element_count = detail::dynamic_count<CountMember>(it.mapping());
+            if (!detail::accept_count(it.mapping().arg_, element_count <= MaxCount))
+            {
+                element_count = 0;
+            }
+
+            auto &&storage = *it.mapping();
+            if constexpr (detail::ResizableStorage<std::remove_reference_t<decltype(storage)>>)
+            {
+                storage.resize(element_count);
+            }
+
+            const size_t stored = detail::stored_count(storage, element_count);
+            for (size_t i = 0; i < stored; ++i)
+            {
+                read_inline<layout<Element>, mapping_list<identity_member>>(
+                    it.layout().get().template stride_offset<element_bytes, offset / 8>(i), storage[i]);
+            }
+
+            return it.advance_dynamic(element_count);
+        }
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto write_span(ZipIterator it)
+        {
+            constexpr size_t offset = ZipIterator::layout_iterator::get_offset();
+            static_assert(offset % 8 == 0, "Arrays must be aligned to byte boundaries.");
+
+            auto &&storage = *it.mapping();
+
+            size_t element_count = detail::dynamic_count<CountMember>(it.mapping());
+            if (!detail::accept_count(it.mapping().arg_, element_count <= MaxCount && element_count <= std::size(storage)))
+            {
+                element_count = 0;
+            }
+
+            for (size_t i = 0; i < element_count; ++i)
+            {
+                write_inline<layout<Element>, mapping_list<identity_member>>(
+                    it.layout().get().template stride_offset<element_bytes, offset / 8>(i), storage[i]);
+            }
+
+            return it.advance_dynamic(element_count);
+        }
+
+        // The count is taken from the host object as it is at that point, so it is filled before the elements. It is cut down to what
+        // the array and its storage can hold, so the object can be written.
+        template <typename MappingIterator, typename Generator>
+        static NETSER_FORCE_INLINE void fill_random(MappingIterator it, Generator &&generator)
+        {
+            const size_t element_count = std::min(detail::dynamic_count<CountMember>(it), MaxCount);
+
+            auto &&storage = *it;
+            if constexpr (detail::ResizableStorage<std::remove_reference_t<decltype(storage)>>)
+            {
+                storage.resize(element_count);
+            }
+
+            const size_t stored = detail::stored_count(storage, element_count);
+            auto &count = detail::count_host(it.arg_).*CountMember;
+            count = static_cast<std::remove_reference_t<decltype(count)>>(stored);
+            for (size_t i = 0; i < stored; ++i)
+            {
+                ::netser::fill_mapping_random<layout_enumerator_t<layout<Element>>>(
+                    make_mapping_iterator<mapping_list<identity_member>>(storage[i]), std::forward<Generator>(generator));
+            }
+        }
+    };
+
+} // namespace netser
+
+#endif
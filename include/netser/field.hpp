@@ -242,8 +242,9 @@ namespace netser
     namespace detail
     {
 
-        // discover_span_size
-        // get the size of the (compatible) integer span given an iterator to the first integer
+        // discover_integer_span_size
+        // get the size of the (compatible) integer span given an iterator to the first integer. Used by both the read and the write
+        // planner.
         template <byte_order Endianess>
         struct is_endianess_integer_field
         {
@@ -267,17 +268,17 @@ namespace netser
         };
 
         template <typename Integer, typename State>
-        struct discover_write_span_size_body
+        struct discover_integer_span_size_body
         {
             using type = std::integral_constant<size_t, Integer::size + State::value>;
         };
 
         template <typename CtRange>
-        using discover_write_span_size =
+        using discover_integer_span_size =
             typename while_<CtRange,
                             is_endianess_integer_field<meta::dereference_t<CtRange>::field::endianess>::template condition, // take the endianess of
                                                                                                                   // the first element.
-                            discover_write_span_size_body, std::integral_constant<size_t, 0>>::type;
+                            discover_integer_span_size_body, std::integral_constant<size_t, 0>>::type;
 
         enum class discover_case
         {
@@ -286,6 +287,16 @@ namespace netser
             finish
         };
 
+        // merge_writes
+        // If NETSER_MERGE_WRITES is defined, the write planner may use an access that reaches beyond the end of an integer span, if the
+        // aligned_ptr's offset range has an upper bound that covers the whole access. The span is then merged into the loaded word under a mask
+        // (read-modify-write), f.e. 3 bytes at a 4-aligned offset become one dword load and store instead of a word and a byte store.
+#ifdef NETSER_MERGE_WRITES
+        constexpr bool merge_writes = true;
+#else
+        constexpr bool merge_writes = false;
+#endif
+
         template <meta::concepts::TypeList List, bool Empty = meta::type_list::is_empty<List>>
         struct front_size_or_zero
         {
@@ -298,29 +309,29 @@ namespace netser
             static constexpr size_t value = meta::type_list::front<List>::size;
         };
 
-        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, size_t FieldWrittenBits, size_t CollectedBits = 0>
+        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, bool Merge, size_t FieldWrittenBits, size_t CollectedBits = 0>
         struct discover_access;
 
-        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, size_t FieldWrittenBits, size_t CollectedBits,
+        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, bool Merge, size_t FieldWrittenBits, size_t CollectedBits,
                   discover_case Case>
         struct discover_switch;
 
-        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, size_t FieldWrittenBits, size_t CollectedBits>
-        struct discover_switch<CtLayoutIterator, AccessList, SpanSize, FieldWrittenBits, CollectedBits, discover_case::add_field>
+        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, bool Merge, size_t FieldWrittenBits, size_t CollectedBits>
+        struct discover_switch<CtLayoutIterator, AccessList, SpanSize, Merge, FieldWrittenBits, CollectedBits, discover_case::add_field>
         {
-            using type = typename discover_access<meta::advance_t<CtLayoutIterator>, AccessList, SpanSize, 0,
+            using type = typename discover_access<meta::advance_t<CtLayoutIterator>, AccessList, SpanSize, Merge, 0,
                                                   CollectedBits + meta::dereference_t<CtLayoutIterator>::size - FieldWrittenBits>::type;
         };
 
-        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, size_t FieldWrittenBits, size_t CollectedBits>
-        struct discover_switch<CtLayoutIterator, AccessList, SpanSize, FieldWrittenBits, CollectedBits, discover_case::grow_write>
+        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, bool Merge, size_t FieldWrittenBits, size_t CollectedBits>
+        struct discover_switch<CtLayoutIterator, AccessList, SpanSize, Merge, FieldWrittenBits, CollectedBits, discover_case::grow_write>
         {
             using type =
-                typename discover_access<CtLayoutIterator, meta::type_list::pop_front<AccessList>, SpanSize, FieldWrittenBits, CollectedBits>::type;
+                typename discover_access<CtLayoutIterator, meta::type_list::pop_front<AccessList>, SpanSize, Merge, FieldWrittenBits, CollectedBits>::type;
         };
 
-        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, size_t FieldWrittenBits, size_t CollectedBits>
-        struct discover_switch<CtLayoutIterator, AccessList, SpanSize, FieldWrittenBits, CollectedBits, discover_case::finish>
+        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, bool Merge, size_t FieldWrittenBits, size_t CollectedBits>
+        struct discover_switch<CtLayoutIterator, AccessList, SpanSize, Merge, FieldWrittenBits, CollectedBits, discover_case::finish>
         {
             using type = meta::type_list::front<AccessList>;
         };
@@ -328,7 +339,12 @@ namespace netser
         // FieldWrittenBits = bits of the Layout front that have already been written in a preceding access
         // AccessList       = list of access, sorted in ascending size (This list must have been cleared of accesses that are unaligned wrt.
         // the layout-iterator) WriteBits        = The amount of bits that have been assembled for this write so far
-        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, size_t FieldWrittenBits, size_t CollectedBits>
+        // SpanSize         = bits of the integer span left, counted from the beginning of the access
+        //
+        // Merge            = whether an access may grow beyond the end of the span (merge_writes and a pointer range with an upper bound)
+        //
+        // The widest access that still fits into the span is taken. With Merge, an access may grow beyond the end of the span.
+        template <typename CtLayoutIterator, typename AccessList, size_t SpanSize, bool Merge, size_t FieldWrittenBits, size_t CollectedBits>
         struct discover_access
         {
             static_assert(!meta::type_list::is_empty<AccessList>, "No access possible.");
@@ -340,33 +356,101 @@ namespace netser
 
             static constexpr size_t field_remaining_bits = field::size - FieldWrittenBits;
 
-            static constexpr bool is_finished = field_remaining_bits + CollectedBits == write::size * 8;
             static constexpr bool need_more_data = field_remaining_bits + CollectedBits < write::size * 8;
-            static constexpr bool need_more_write = field_remaining_bits + CollectedBits > write::size * 8;
+            static constexpr bool span_complete = field_remaining_bits + CollectedBits >= SpanSize;
+            static constexpr bool has_bigger_write = (meta::type_list::size<AccessList> > 1);
             static constexpr bool can_grow_write
-                = (meta::type_list::size<AccessList> > 1) && front_size_or_zero<meta::type_list::pop_front<AccessList>>::value * 8 <= SpanSize;
+                = has_bigger_write && front_size_or_zero<meta::type_list::pop_front<AccessList>>::value * 8 <= SpanSize;
+            static constexpr bool can_merge_write = Merge && has_bigger_write && write::size * 8 < SpanSize;
+
+            static constexpr discover_case this_case
+                = need_more_data ? (span_complete ? discover_case::finish : discover_case::add_field)
+                                 : ((can_grow_write || can_merge_write) ? discover_case::grow_write : discover_case::finish);
+
+            using type = typename discover_switch<CtLayoutIterator, AccessList, SpanSize, Merge, FieldWrittenBits, CollectedBits, this_case>::type;
+        };
+
+        // swap_field_bytes
+        // Spans are assembled in memory order, most significant bit first. A multi-byte little endian field has its bytes reversed in
+        // memory order, so its value is swapped within its own bytes when it is extracted from or inserted into a word.
+        template <typename Field, typename T>
+        NETSER_FORCE_INLINE constexpr T swap_field_bytes(T value)
+        {
+            if constexpr (Field::endianess == byte_order::little_endian && Field::size > 8)
+            {
+                static_assert(Field::size % 8 == 0, "Multi-byte little endian fields must span whole bytes.");
+                return static_cast<T>(conditional_swap<true>(value) >> (sizeof(T) * 8 - Field::size));
+            }
+            else
+            {
+                return value;
+            }
+        }
 
-            static constexpr discover_case this_case = (is_finished || (need_more_write && !can_grow_write))
-                                                           ? discover_case::finish
-                                                           : (need_more_data ? discover_case::add_field : discover_case::grow_write);
+        // memory_order_value
+        // Value of the field a zip iterator points at, in memory order (see swap_field_bytes).
+        template <typename ZipIterator>
+        NETSER_FORCE_INLINE auto memory_order_value(ZipIterator it)
+        {
+            using field = typename meta::dereference_t<typename ZipIterator::layout_iterator>::field;
+            return swap_field_bytes<field>(static_cast<typename field::stage_type>(*it.mapping()));
+        }
 
-            using type = typename discover_switch<CtLayoutIterator, AccessList, SpanSize, FieldWrittenBits, CollectedBits, this_case>::type;
+        // zip_field_size
+        // size of the field a zip iterator points at, 0 for the end iterator
+        template <typename ZipIterator, bool IsEnd = ZipIterator::is_end>
+        struct zip_field_size
+        {
+            static constexpr size_t value = meta::dereference_t<typename ZipIterator::layout_iterator>::field::size;
         };
 
+        template <typename ZipIterator>
+        struct zip_field_size<ZipIterator, true>
+        {
+            static constexpr size_t value = 0;
+        };
+
+        // observe_word
+        // Hands the bytes [Begin, End) of a loaded or stored word to the root argument of the mapping if it accepts them (see
+        // read_checksummed). Word holds the bytes from WordBegin on in memory order, all offsets are relative to the layout's pointer.
+        // Plain reads and writes compile to nothing here.
+        template <int WordBegin, int Begin, int End, typename MappingIterator, typename Word>
+        NETSER_FORCE_INLINE void observe_word(const MappingIterator &it, Word word)
+        {
+            if constexpr (End > Begin && requires { it.arg_.observe_bytes(std::uint64_t(0), size_t(0), size_t(0)); })
+            {
+                static_assert(sizeof(Word) <= sizeof(std::uint64_t), "Words must fit 64 bits.");
+                constexpr int shift = 8 * (WordBegin + int(sizeof(Word)) - End);
+                it.arg_.observe_bytes((std::uint64_t(word) >> shift) & bit_mask<std::uint64_t>(8 * (End - Begin)), size_t(End - Begin),
+                                      size_t(Begin));
+            }
+        }
+
         struct write_integer_algorithm
         {
           private:
+            // observe_stored
+            // Hands the span's bytes of a stored word (in memory order) to observe_word. Spans start at byte boundaries.
+            template <typename PlacedAccess, size_t SpanSize, typename ZipIterator, typename Word>
+            NETSER_FORCE_INLINE static void observe_stored(const ZipIterator &it, Word val)
+            {
+                constexpr int begin = PlacedAccess::byte_offset;
+                observe_word<begin, begin, min<int>(begin + int(PlacedAccess::size), int(PlacedAccess::bits_offset + SpanSize) / 8)>(
+                    it.mapping(), val);
+            }
+
             enum class execute_action
             {
                 write,
                 write_and_continue,
                 collect_all,
                 collect_partial,
+                merge,
                 error
             };
 
-            static constexpr execute_action determine_execute_action(size_t access_size, size_t access_written, size_t field_size,
-                                                                     size_t field_written)
+            static constexpr execute_action determine_execute_action(size_t access_size, size_t access_written, size_t span_size,
+                                                                     size_t field_size, size_t field_written)
             {
                 if (access_written <= access_size)
                 {
@@ -377,6 +461,10 @@ namespace netser
                         else
                             return execute_action::write_and_continue;
                     }
+                    else if (access_written == span_size)
+                    {
+                        return execute_action::merge;
+                    }
                     else
                     {
                         if (access_written + field_size - field_written <= access_size)
@@ -391,8 +479,9 @@ namespace netser
                 }
             }
 
-            template <typename PlacedAccess, byte_order Endianess, size_t FieldSize, size_t BitsWritten = 0, size_t FieldWritten = 0,
-                      execute_action Task = determine_execute_action(PlacedAccess::size * 8, BitsWritten, FieldSize, FieldWritten)>
+            template <typename PlacedAccess, size_t SpanSize, size_t FieldSize, size_t BitsWritten = 0,
+                      size_t FieldWritten = 0,
+                      execute_action Task = determine_execute_action(PlacedAccess::size * 8, BitsWritten, SpanSize, FieldSize, FieldWritten)>
             struct execute_access
             {
 
@@ -403,8 +492,9 @@ namespace netser
             };
 
             // Access complete, no partial field remaining
-            template <typename PlacedAccess, byte_order Endianess, size_t FieldSize, size_t BitsWritten, size_t FieldWritten>
-            struct execute_access<PlacedAccess, Endianess, FieldSize, BitsWritten, FieldWritten, execute_action::write>
+            template <typename PlacedAccess, size_t SpanSize, size_t FieldSize, size_t BitsWritten,
+                      size_t FieldWritten>
+            struct execute_access<PlacedAccess, SpanSize, FieldSize, BitsWritten, FieldWritten, execute_action::write>
             {
                 using type = typename PlacedAccess::type;
 
@@ -413,7 +503,8 @@ namespace netser
                 {
                     static_assert(FieldWritten == 0, "Huh?");
 
-                    PlacedAccess::template write(it.layout().get(), conditional_swap<PlacedAccess::endianess != Endianess>(val));
+                    PlacedAccess::template write(it.layout().get(), conditional_swap<PlacedAccess::endianess != byte_order::big_endian>(val));
+                    observe_stored<PlacedAccess, SpanSize>(it, val);
 
                     return it;
                 }
@@ -428,15 +519,18 @@ namespace netser
             };
 
             // Access complete, partial field remaining
-            template <typename PlacedAccess, byte_order Endianess, size_t FieldSize, size_t BitsWritten, size_t FieldWritten>
-            struct execute_access<PlacedAccess, Endianess, FieldSize, BitsWritten, FieldWritten, execute_action::write_and_continue>
+            template <typename PlacedAccess, size_t SpanSize, size_t FieldSize, size_t BitsWritten,
+                      size_t FieldWritten>
+            struct execute_access<PlacedAccess, SpanSize, FieldSize, BitsWritten, FieldWritten,
+                                  execute_action::write_and_continue>
             {
                 using type = typename PlacedAccess::type;
 
                 template <typename ZipIterator>
                 NETSER_FORCE_INLINE static auto execute(ZipIterator it, type val = 0)
                 {
-                    PlacedAccess::template write(it.layout().get(), conditional_swap<PlacedAccess::endianess != Endianess>(val));
+                    PlacedAccess::template write(it.layout().get(), conditional_swap<PlacedAccess::endianess != byte_order::big_endian>(val));
+                    observe_stored<PlacedAccess, SpanSize>(it, val);
 
 #ifdef NETSER_DEBUG_CONSOLE
                     PlacedAccess::describe();
@@ -451,8 +545,9 @@ namespace netser
             // layout: ...aaaaaaaabbbbbbbb...        -> done
             // layout: ...aaaabbbbbbbbbbbb...        -> continue and cap on next step
             // access: ...xxxxxxxx]                  (shift down 5, mask 8 bits)
-            template <typename PlacedAccess, byte_order Endianess, size_t FieldSize, size_t BitsWritten, size_t FieldWritten>
-            struct execute_access<PlacedAccess, Endianess, FieldSize, BitsWritten, FieldWritten, execute_action::collect_all>
+            template <typename PlacedAccess, size_t SpanSize, size_t FieldSize, size_t BitsWritten,
+                      size_t FieldWritten>
+            struct execute_access<PlacedAccess, SpanSize, FieldSize, BitsWritten, FieldWritten, execute_action::collect_all>
             {
                 using type = typename PlacedAccess::type;
                 static constexpr size_t num_bits = FieldSize - FieldWritten;
@@ -461,8 +556,11 @@ namespace netser
                 template <typename ZipIterator>
                 NETSER_FORCE_INLINE static auto execute(ZipIterator it, type val = 0)
                 {
-                    return execute_access<PlacedAccess, Endianess, FieldSize, BitsWritten + num_bits, 0>::template execute(
-                        ++it, val | ((bit_mask<type>(num_bits) & static_cast<type>(*it.mapping())) << shift_up));
+                    const auto value = static_cast<type>(memory_order_value(it));
+
+                    // The next step works on the next field, so take along its size.
+                    return execute_access<PlacedAccess, SpanSize, zip_field_size<decltype(++it)>::value, BitsWritten + num_bits,
+                                          0>::template execute(++it, val | ((bit_mask<type>(num_bits) & value) << shift_up));
                 }
             };
 
@@ -470,8 +568,9 @@ namespace netser
             // Layout field a, Memory access x
             // layout: ...aaaaaaaaaaaaa...
             // access: ...xxxxxxxx]                  (shift down 5, mask 8 bits)
-            template <typename PlacedAccess, byte_order Endianess, size_t FieldSize, size_t BitsWritten, size_t FieldWritten>
-            struct execute_access<PlacedAccess, Endianess, FieldSize, BitsWritten, FieldWritten, execute_action::collect_partial>
+            template <typename PlacedAccess, size_t SpanSize, size_t FieldSize, size_t BitsWritten,
+                      size_t FieldWritten>
+            struct execute_access<PlacedAccess, SpanSize, FieldSize, BitsWritten, FieldWritten, execute_action::collect_partial>
             {
                 template <size_t bits_to_write, size_t field_remaining>
                 struct validate : public std::true_type
@@ -491,12 +590,34 @@ namespace netser
                     std::cout << "Shifting down by " << shift_down << " bits.";
 #endif
 
-                    return execute_access<PlacedAccess, Endianess, FieldSize, BitsWritten + num_bits,
-                                          FieldWritten + num_bits>::template execute(it,
-                                                                                     val
-                                                                                         | (bit_mask<type>(num_bits)
-                                                                                            & static_cast<type>(*it.mapping()
-                                                                                                                >> shift_down)));
+                    return execute_access<PlacedAccess, SpanSize, FieldSize, BitsWritten + num_bits, FieldWritten + num_bits>::template execute(
+                        it, val | (bit_mask<type>(num_bits) & static_cast<type>(memory_order_value(it) >> shift_down)));
+                }
+            };
+
+            // Span complete, access not full (merge_writes only)
+            // Layout field a, Memory access x, bytes outside of the span o
+            // layout: ...aaaaaaaaaaaa|oooo
+            // access: ...xxxxxxxxxxxxxxxx]     (load, keep the o bits, store)
+            template <typename PlacedAccess, size_t SpanSize, size_t FieldSize, size_t BitsWritten,
+                      size_t FieldWritten>
+            struct execute_access<PlacedAccess, SpanSize, FieldSize, BitsWritten, FieldWritten, execute_action::merge>
+            {
+                using type = typename PlacedAccess::type;
+                static constexpr type mask = static_cast<type>(bit_mask<type>(BitsWritten) << (PlacedAccess::size * 8 - BitsWritten));
+
+                template <typename ZipIterator>
+                NETSER_FORCE_INLINE static auto execute(ZipIterator it, type val = 0)
+                {
+                    static_assert(FieldWritten == 0, "Huh?");
+
+                    const auto ptr = it.layout().get();
+                    const type old = PlacedAccess::read(ptr);
+                    constexpr bool swap = PlacedAccess::endianess != byte_order::big_endian;
+                    PlacedAccess::write(ptr, static_cast<type>((old & static_cast<type>(~conditional_swap<swap>(mask))) | conditional_swap<swap>(val)));
+                    observe_stored<PlacedAccess, SpanSize>(it, val);
+
+                    return it;
                 }
             };
 
@@ -509,7 +630,7 @@ namespace netser
                 using placed_field = meta::dereference_t<layout_iterator_ct>;
                 using field = typename placed_field::field;
                 using ptr_type = typename layout_iterator::pointer_type;
-                constexpr size_t span_size = detail::discover_write_span_size<layout_iterator_ct>::value - FieldWritten;
+                constexpr size_t span_size = detail::discover_integer_span_size<layout_iterator_ct>::value - FieldWritten;
 
 #ifdef NETSER_DEBUG_CONSOLE
                 std::cout << "\n    Aligned Ptr: ";
@@ -522,7 +643,7 @@ namespace netser
                 using access = typename discover_access<
                     layout_iterator_ct,
                     filtered_accesses_nomove_t<ptr_type, (layout_iterator::get_offset() + FieldWritten) / 8, platform_memory_accesses>,
-                    span_size, FieldWritten>::type;
+                    span_size, merge_writes && ptr_type::offset_range::has_upper_bound, FieldWritten>::type;
 
 #ifdef NETSER_DEBUG_CONSOLE
                 std::cout << "\n    Would like to use size " << access::size << "\n";
@@ -532,13 +653,298 @@ namespace netser
 
                 static_assert((placed_field::offset + FieldWritten) % 8 == 0, "Something's bad!");
 
-                return execute_access<placed_access, field::endianess, field::size, 0, FieldWritten>::template execute(it);
+                return execute_access<placed_access, span_size, field::size, 0, FieldWritten>::template execute(it);
             }
         };
 
     } // namespace detail
 
 
+    //=============
+    // read_span span planner
+    //
+
+    namespace detail
+    {
+
+        // span_coverage
+        // Number of bits of the span [Position, SpanEnd) that are covered by the (aligned down) access.
+        template <typename Access, typename AlignedPtr, int Position, int SpanEnd>
+        constexpr size_t span_coverage()
+        {
+            constexpr bit_range range = Access::template aligned_range<Position, AlignedPtr>();
+            return (range.end() > Position) ? size_t(min<int>(range.end(), SpanEnd) - Position) : 0;
+        }
+
+        // select_span_access
+        // Select the access which covers most of the remaining span. On ties the smaller access wins.
+        template <typename AlignedPtr, int Position, int SpanEnd, typename PossibleAccesses>
+        struct select_span_access;
+
+        template <typename AlignedPtr, int Position, int SpanEnd>
+        struct select_span_access<AlignedPtr, Position, SpanEnd, meta::tlist<>>
+        {
+            static_assert(Position != Position, "No matching read!");
+        };
+
+        template <typename AlignedPtr, int Position, int SpanEnd, typename Access0>
+        struct select_span_access<AlignedPtr, Position, SpanEnd, meta::tlist<Access0>>
+        {
+            using type = Access0;
+        };
+
+        template <typename AlignedPtr, int Position, int SpanEnd, typename Access0, typename Access1, typename... AccessList>
+        struct select_span_access<AlignedPtr, Position, SpanEnd, meta::tlist<Access0, Access1, AccessList...>>
+        {
+            using best_of_tail = typename select_span_access<AlignedPtr, Position, SpanEnd, meta::tlist<Access1, AccessList...>>::type;
+
+            using type = std::conditional_t<(span_coverage<Access0, AlignedPtr, Position, SpanEnd>()
+                                             >= span_coverage<best_of_tail, AlignedPtr, Position, SpanEnd>()),
+                                            Access0, best_of_tail>;
+        };
+
+        // validate_read
+        // Reports the value of every extracted integer field to the root argument of the mapping if it accepts it (see read_validated).
+        // Plain reads compile to nothing here.
+        template <typename MappingIterator, typename Value>
+        NETSER_FORCE_INLINE void validate_read(const MappingIterator &it, Value value)
+        {
+            if constexpr (requires { it.arg_.validate_field_value(it, value); })
+            {
+                it.arg_.validate_field_value(it, value);
+            }
+        }
+
+        // read_integer_algorithm
+        // Read side counterpart of write_integer_algorithm. Instead of generating an access list per field, every access is chosen to
+        // cover as much of the integer span as possible. Each loaded word is then used to extract all fields it covers with shift and
+        // mask. A field which is cut by the end of a word is carried over into the next access.
+        struct read_integer_algorithm
+        {
+          private:
+            // extract
+            // Word      = loaded word, already swapped to memory order (big endian)
+            // BitPos    = position of the current field's first unread bit inside Word
+            // SpanBits  = bits left in the span, including the unread bits of the current field
+            // FieldRead = bits of the current field that have been assembled by preceding accesses into partial
+            template <size_t AccessBits, size_t BitPos, size_t SpanBits, size_t FieldRead, typename ZipIterator, typename WordType,
+                      typename StageType>
+            NETSER_FORCE_INLINE static auto extract(ZipIterator it, WordType word, StageType partial)
+            {
+                using field = typename meta::dereference_t<typename ZipIterator::layout_iterator>::field;
+                using stage_type = typename field::stage_type;
+                constexpr size_t field_remaining = field::size - FieldRead;
+
+                if constexpr (BitPos + field_remaining <= AccessBits)
+                {
+                    // Layout field a, Memory access x
+                    // layout: ...aaaaaaabbbb...
+                    // access: ...xxxxxxxxxxxxxxxx]    (shift down, mask, continue with b on the same word)
+                    auto value = static_cast<stage_type>((word >> (AccessBits - BitPos - field_remaining))
+                                                         & bit_mask<WordType>(field_remaining));
+
+                    if constexpr (FieldRead != 0)
+                    {
+                        value = static_cast<stage_type>(value | (static_cast<stage_type>(partial) << field_remaining));
+                    }
+
+                    value = swap_field_bytes<field>(value);
+
+                    using target_type = std::remove_reference_t<decltype(*it.mapping())>;
+                    if constexpr (std::is_enum_v<target_type>)
+                    {
+                        // Enums held directly (array elements, packet_view results) rather than through an enum_wrapper
+                        *it.mapping() = static_cast<target_type>(value);
+                    }
+                    else
+                    {
+                        *it.mapping() = static_cast<typename field::integral_type>(value);
+                    }
+                    validate_read(it.mapping(), static_cast<typename field::integral_type>(value));
+
+                    if constexpr (SpanBits == field_remaining || BitPos + field_remaining == AccessBits)
+                    {
+                        // Either the span is complete or the word is used up, the outer loop restarts on the next field.
+                        return ++it;
+                    }
+                    else
+                    {
+                        return extract<AccessBits, BitPos + field_remaining, SpanBits - field_remaining, 0>(++it, word, stage_type(0));
+                    }
+                }
+                else
+                {
+                    // Layout field a, Memory access x
+                    // layout: ...aaaaaaaaaaaaa...
+                    // access: ...xxxxxxxx]            (mask, carry over to the next access)
+                    constexpr size_t num_bits = AccessBits - BitPos;
+                    auto value = static_cast<stage_type>(word & bit_mask<WordType>(num_bits));
+
+                    if constexpr (FieldRead != 0)
+                    {
+                        value = static_cast<stage_type>(value | (static_cast<stage_type>(partial) << num_bits));
+                    }
+
+                    return read_integer<FieldRead + num_bits>(it, value);
+                }
+            }
+
+          public:
+            template <size_t FieldRead = 0, typename ZipIterator, typename StageType = unsigned char>
+            NETSER_FORCE_INLINE static auto read_integer(ZipIterator it, StageType partial = 0)
+            {
+                using layout_iterator = typename ZipIterator::layout_iterator;
+                using layout_iterator_ct = typename layout_iterator::iterator;
+                using ptr_type = typename layout_iterator::pointer_type;
+
+                constexpr int position = int(layout_iterator::get_offset() + FieldRead);
+                constexpr size_t span_size = detail::discover_integer_span_size<layout_iterator_ct>::value - FieldRead;
+
+                using access = typename select_span_access<ptr_type, position, position + int(span_size),
+                                                           filtered_accesses_t<ptr_type, position / 8, platform_memory_accesses>>::type;
+                using placed_access = placed_memory_access<access, position, ptr_type>;
+
+#ifdef NETSER_DEBUG_CONSOLE
+                std::cout << "\n    Span read at " << position << " (" << span_size << " bits) using size " << access::size << "\n";
+#endif
+
+                auto word = conditional_swap<access::endianess != byte_order::big_endian>(placed_access::read(it.layout().get()));
+                observe_word<placed_access::range.begin() / 8, position / 8,
+                             min<int>(placed_access::range.end(), position + int(span_size)) / 8>(it.mapping(), word);
+                return extract<access::size * 8, position - placed_access::range.begin(), span_size, FieldRead>(it, word, partial);
+            }
+        };
+
+    } // namespace detail
+
+    //=============
+    // staged read
+    //
+
+    namespace detail
+    {
+
+        // staged_reads
+        // If NETSER_STAGED_READS is defined, reads copy layouts of up to staged_read_max_bytes into a local buffer aligned for the
+        // widest platform access with one bulk copy and runs the span planner on that buffer instead of the source. This only happens if
+        // the source alignment restricts the span planner to narrower accesses than the local buffer allows, f.e. a 34 byte header at an
+        // odd address: a few wide unaligned loads by the bulk copy, then the fields are extracted with shifts from fully aligned words
+        // the compiler can keep in registers.
+#ifdef NETSER_STAGED_READS
+        constexpr bool staged_reads = true;
+#else
+        constexpr bool staged_reads = false;
+#endif
+
+        constexpr size_t staged_read_max_bytes = 64;
+
+        template <typename AccessList, bool Empty = meta::type_list::is_empty<AccessList>>
+        struct max_access_size
+        {
+            static constexpr size_t value = 0;
+        };
+
+        template <typename AccessList>
+        struct max_access_size<AccessList, false>
+        {
+            static constexpr size_t value
+                = max<size_t>(meta::type_list::front<AccessList>::size, max_access_size<meta::type_list::pop_front<AccessList>>::value);
+        };
+
+        // staging_alignment
+        // Alignment of the staging buffer, enough for every platform access.
+        constexpr size_t staging_alignment = max_access_size<platform_memory_accesses>::value;
+
+        // prefer_staged_read_v
+        // true iff a layout of LayoutBits should be read through a staging buffer from a source described by AlignedPtr.
+        template <typename AlignedPtr, size_t LayoutBits>
+        constexpr bool prefer_staged_read_v
+            = staged_reads && LayoutBits % 8 == 0 && LayoutBits > 0 && LayoutBits / 8 <= staged_read_max_bytes
+              && AlignedPtr::offset_range::contains(0, int(LayoutBits / 8))
+              && max_access_size<legal_memory_accesses<AlignedPtr::get_max_alignment()>>::value < staging_alignment;
+
+    } // namespace detail
+
+
+    //=============
+    // single field setter
+    //
+
+    namespace detail
+    {
+
+        // access_size_filter
+        // Filter for erase_if that removes accesses wider than MaxSize bytes.
+        template <size_t MaxSize>
+        struct access_size_filter
+        {
+            template <typename AccessType>
+            struct filter
+            {
+                static constexpr bool value = AccessType::size > MaxSize;
+            };
+        };
+
+        // set_integer_algorithm
+        // Writes one integer field in place. Accesses start at the field's first byte, like on the write path, and never reach past its
+        // last byte: the whole bytes of the field are written with plain stores, only a first or last byte the field covers partially
+        // is merged under a mask (read-modify-write), so neighbouring bits are preserved.
+        struct set_integer_algorithm
+        {
+            // set
+            // Position, End = bits of the field relative to ptr
+            // value         = field value
+            template <typename Field, int Position, int End, typename AlignedPtr, typename StageType>
+            NETSER_FORCE_INLINE static void set(AlignedPtr ptr, StageType value)
+            {
+                set_bits<Position, End>(ptr, swap_field_bytes<Field>(value));
+            }
+
+          private:
+            // set_bits
+            // Position, End = bits of the field that are left to write, relative to ptr
+            // value         = field value in memory order (see swap_field_bytes), its End - Position low bits are written
+            template <int Position, int End, typename AlignedPtr, typename StageType>
+            NETSER_FORCE_INLINE static void set_bits(AlignedPtr ptr, StageType value)
+            {
+                // A partial byte is merged on its own, whole bytes are stored with the widest access that ends within them
+                constexpr size_t max_size = (Position % 8 == 0 && End - Position >= 8) ? size_t(End - Position) / 8 : 1;
+                using possible_accesses
+                    = meta::type_list::erase_if<filtered_accesses_nomove_t<AlignedPtr, Position / 8, platform_memory_accesses>,
+                                                access_size_filter<max_size>::template filter>;
+
+                using access = typename select_span_access<AlignedPtr, Position, End, possible_accesses>::type;
+                using placed_access = placed_memory_access<access, Position / 8 * 8, AlignedPtr>;
+                using word_type = typename access::type;
+
+                constexpr int word_bits = int(access::size * 8);
+                constexpr int covered_end = min<int>(End, placed_access::range.begin() + word_bits);
+                constexpr size_t num_bits = size_t(covered_end - Position);
+                constexpr size_t shift = size_t(placed_access::range.begin() + word_bits - covered_end);
+
+                const auto bits = static_cast<word_type>(
+                    static_cast<word_type>((value >> (End - covered_end)) & bit_mask<StageType>(num_bits)) << shift);
+
+                if constexpr (num_bits == size_t(word_bits))
+                {
+                    placed_access::write(ptr, conditional_swap<access::endianess != byte_order::big_endian>(bits));
+                }
+                else
+                {
+                    constexpr auto mask = static_cast<word_type>(bit_mask<word_type>(num_bits) << shift);
+                    const auto old = conditional_swap<access::endianess != byte_order::big_endian>(placed_access::read(ptr));
+                    placed_access::write(ptr, conditional_swap<access::endianess != byte_order::big_endian>(
+                                                  static_cast<word_type>((old & static_cast<word_type>(~mask)) | bits)));
+                }
+
+                if constexpr (covered_end < End)
+                {
+                    set_bits<covered_end, End>(ptr, value);
+                }
+            }
+        };
+
+    } // namespace detail
 
 } // namespace netser
 
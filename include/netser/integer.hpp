@@ -91,12 +91,6 @@ namespace netser
             return std::numeric_limits<stage_type>::max() & bit_mask<stage_type>(Bits - (Signed ? 1 : 0));
         }
 
-      private:
-        // defined in integer_read.hpp
-        template <typename LayoutIterator>
-        static constexpr NETSER_FORCE_INLINE integral_type read(LayoutIterator it);
-
-      public:
         // defined in integer_read.hpp
         template <typename ZipIterator>
         static constexpr NETSER_FORCE_INLINE auto read_span(ZipIterator it);
@@ -114,7 +108,11 @@ namespace netser
 
             using lhs_type = std::remove_reference_t<decltype(*it)>;
 
-            *it = static_cast<lhs_type>(static_cast<stage_type>(dis(generator)));
+            // Proxies (enum_wrapper, constant_reference) convert on assignment
+            if constexpr (std::is_arithmetic_v<lhs_type> || std::is_enum_v<lhs_type>)
+                *it = static_cast<lhs_type>(static_cast<stage_type>(dis(generator)));
+            else
+                *it = static_cast<stage_type>(dis(generator));
         }
 
         template <typename DestType, typename T>
@@ -139,25 +137,6 @@ namespace netser
     constexpr bool is_integer_v = is_integer<T>::value;
 
 
-    template <bool Signed, size_t Bits, byte_order ByteOrder>
-    template <typename LayoutIterator>
-    constexpr typename int_<Signed, Bits, ByteOrder>::integral_type
-    int_<Signed, Bits, ByteOrder>::read(LayoutIterator layit)
-    {
-#ifdef NETSER_DEBUG_CONSOLE
-        std::cout << "Generating memory access List (";
-        std::cout << "Field size: " << meta::dereference_t<typename LayoutIterator::range>::size
-                  << " bits. Ptr-Alignment: " << layit.get_access_alignment(0) << ")... ";
-#endif
-        using accesses = detail::generate_partial_memory_access_list_t<LayoutIterator, unsigned int>;
-
-#ifdef NETSER_DEBUG_CONSOLE
-        detail::describe_generate_partial_memory_access_list_t<LayoutIterator, unsigned int>();
-        std::cout << "Got " << list_size_v<accesses> << " reads.\n";
-#endif
-        return static_cast<integral_type>(detail::template run_access_list<accesses>::template run<stage_type>(layit.get()));
-    }
-
     template <bool Signed, size_t Bits, byte_order ByteOrder>
     template <typename ZipIterator>
     constexpr auto int_<Signed, Bits, ByteOrder>::read_span(ZipIterator it)
@@ -168,12 +147,8 @@ namespace netser
 #ifdef NETSER_DEBUG_CONSOLE
         std::cout << "reading integer span:\n";
 #endif
-        *it.mapping() = read(it.layout());
-
-#ifdef NETSER_DEBUG_CONSOLE
-        std::cout << "read span complete.\n";
-#endif
-        return ++it;
+        // Reads all following integers of the same byte order with shared loads, see detail::read_integer_algorithm.
+        return detail::read_integer_algorithm::read_integer<>(it);
     }
 
     template <bool Signed, size_t Bits, byte_order ByteOrder>
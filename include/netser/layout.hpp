@@ -87,6 +87,54 @@ namespace netser
     template<typename Layout>
     using layout_enumerator_t = layout_meta_iterator< meta::tree_begin<Layout, layout_tree_ctx, meta::traversals::lr> >;
 
+    namespace detail
+    {
+
+        template <typename LayoutMetaIterator, bool IsEnd = meta::concepts::EmptyRange<LayoutMetaIterator>>
+        struct layout_end_offset
+        {
+            static constexpr size_t value = layout_end_offset<meta::advance_t<LayoutMetaIterator>>::value;
+        };
+
+        template <typename LayoutMetaIterator>
+        struct layout_end_offset<LayoutMetaIterator, true>
+        {
+            static constexpr size_t value = LayoutMetaIterator::get_offset();
+        };
+
+    } // namespace detail
+
+    // layout_size_v
+    // Static size of a layout in bits.
+    template <typename Layout>
+    constexpr size_t layout_size_v = detail::layout_end_offset<layout_enumerator_t<Layout>>::value;
+
+    namespace detail
+    {
+
+        template <typename Field>
+        constexpr bool is_dynamic_field_v = requires { requires Field::is_dynamic; };
+
+        template <typename LayoutMetaIterator, bool IsEnd = meta::concepts::EmptyRange<LayoutMetaIterator>>
+        struct layout_has_dynamic
+        {
+            static constexpr bool value = is_dynamic_field_v<typename meta::dereference_t<LayoutMetaIterator>::field>
+                                          || layout_has_dynamic<meta::advance_t<LayoutMetaIterator>>::value;
+        };
+
+        template <typename LayoutMetaIterator>
+        struct layout_has_dynamic<LayoutMetaIterator, true>
+        {
+            static constexpr bool value = false;
+        };
+
+    } // namespace detail
+
+    // layout_is_dynamic_v
+    // true iff a field of the layout has a runtime length (see dynamic_array). layout_size_v then only counts the static part.
+    template <typename Layout>
+    constexpr bool layout_is_dynamic_v = detail::layout_has_dynamic<layout_enumerator_t<Layout>>::value;
+
     namespace detail
     {
         namespace impl
@@ -147,6 +195,17 @@ namespace netser
             }
         }
 
+        // advance_dynamic
+        // Like operator++, but hands the runtime state of a dynamic-length field (f.e. its element count) to its transform_buffer.
+        // The pointer type may change, so the following fields are planned with the residue class the new pointer can still prove.
+        template <typename... Args>
+        constexpr auto advance_dynamic(Args... args) const
+        {
+            using next_pointer = decltype(meta::dereference_t<LayoutRange>::field::transform_buffer(buffer_, args...));
+            return layout_iterator<next_pointer, meta::advance_t<LayoutRange>>(
+                meta::dereference_t<LayoutRange>::field::transform_buffer(buffer_, args...));
+        }
+
         static constexpr size_t get_pointer_alignment()
         {
             return AlignedPtr::get_pointer_alignment();
@@ -22,8 +22,10 @@ namespace netser
     template<typename Mapping>
     using mapping_range_t = meta::tree_range_t<Mapping, meta::contexts::intrusive, meta::traversals::lr>;
 
+    // dereference
+    // Applies the mappings of the path to arg. Mappings that return proxies (enum_wrapper, constant_reference) yield them by value.
     template<meta::concepts::Enumerator MappingPath, typename T>
-    auto&& dereference(T&& arg)
+    decltype(auto) dereference(T&& arg)
     {
         if constexpr (!meta::concepts::Sentinel<MappingPath>)
         {
@@ -31,9 +33,13 @@ namespace netser
                 meta::dereference_t<MappingPath>::apply(std::forward<T>(arg))
             );
         }
+        else if constexpr (std::is_lvalue_reference_v<T>)
+        {
+            return static_cast<T>(arg);
+        }
         else
         {
-            return arg;
+            return std::remove_cvref_t<T>(std::move(arg));
         }
     }
 
@@ -48,6 +54,7 @@ namespace netser
     struct mapping_iterator
     {
       public:
+        using range = MappingRange;
         using path_enumerator = meta::path_enumerator_t<MappingRange>;
 
         static constexpr bool is_end = false;
@@ -61,7 +68,7 @@ namespace netser
             return netser::dereference<path_enumerator>(arg_);
         }
 
-        constexpr auto &operator*() const
+        constexpr decltype(auto) operator*() const
         {
             return netser::dereference<path_enumerator>(arg_);
         }
@@ -82,7 +89,7 @@ namespace netser
 
         static constexpr bool is_end = true;
 
-        constexpr mapping_iterator(Arg &ref [[maybe_unused]])
+        constexpr mapping_iterator(Arg arg) : arg_(arg)
         {
         }
 
@@ -95,6 +102,9 @@ namespace netser
         {
             return meta::error_type();
         }
+
+        // The root argument is kept behind the last leaf, so hooks of the root argument (see detail::observe_word) still reach it.
+        Arg arg_;
     };
 
     template <typename Mapping, typename Arg>
@@ -188,7 +198,7 @@ namespace netser
         T &enum_;
     };
 
-    template<auto MemberPtr, bool IsEnum = std::is_enum_v<decltype(MemberPtr)>>
+    template<auto MemberPtr, bool IsEnum = std::is_enum_v<typename member_object_pointer_traits<MemberPtr>::value_type>>
     requires(concepts::MemberPtr<MemberPtr>)
     struct mem
     {
@@ -233,18 +243,32 @@ namespace netser
         static constexpr const value_type container_type::*const_pointer = MemberPtr;
 
         template <typename Ref>
-        static enum_wrapper<value_type> dereference(Ref &ref)
+        static enum_wrapper<value_type> apply(Ref &ref)
         {
             return {ref.*pointer};
         }
 
         template <typename Ref>
-        static enum_wrapper<const value_type> dereference(const Ref &ref)
+        static enum_wrapper<const value_type> apply(const Ref &ref)
         {
             return {ref.*const_pointer};
         }
     };
 
+    namespace detail
+    {
+
+        // same_member_v
+        // true iff the mapping node Mapping is mem<MemberPtr>
+        template <typename Mapping, auto MemberPtr>
+        constexpr bool same_member_v = false;
+
+        template <auto Ptr, bool IsEnum, auto MemberPtr>
+        constexpr bool same_member_v<mem<Ptr, IsEnum>, MemberPtr>
+            = std::is_same_v<std::integral_constant<decltype(Ptr), Ptr>, std::integral_constant<decltype(MemberPtr), MemberPtr>>;
+
+    } // namespace detail
+
     namespace detail
     {
 
@@ -323,6 +347,8 @@ namespace netser
             constant_reference(T)
             {}
 
+            constant_reference(const constant_reference&) = default;
+
             operator T() const
             {
                 return value;
@@ -19,7 +19,8 @@ namespace netser
     };
 
     // atomic_memory_access
-    //
+    // Describes a memory access the platform can execute in one instruction. Alignment may be lower than the natural alignment of
+    // Type (down to 1 for platforms with unaligned access support), aligned_ptr::load/store then copy instead of dereferencing.
     //
     template <typename Type, size_t Size, size_t Alignment, byte_order Endianess>
     struct atomic_memory_access
@@ -32,13 +33,13 @@ namespace netser
         template <int Offset, typename AlignedPtr> requires(Offset % 8 == 0)
         static type read(AlignedPtr src)
         {
-            return src.template dereference<const type, Offset / 8>();
+            return src.template load<type, Offset / 8>();
         }
 
         template <int Offset, typename AlignedPtr> requires(Offset % 8 == 0)
-        static type write(AlignedPtr dest, type value)
+        static void write(AlignedPtr dest, type value)
         {
-            dest.template dereference<type, Offset / 8>() = value;
+            dest.template store<type, Offset / 8>(value);
         }
 
 /*
@@ -98,14 +99,14 @@ namespace netser
         requires(AlignedPtr::get_access_alignment(byte_offset) % atomic_access::alignment == 0)
         static typename atomic_access::type read(AlignedPtr src)
         {
-            return src.template dereference<const typename atomic_access::type, byte_offset>();
+            return src.template load<typename atomic_access::type, byte_offset>();
         }
 
         template <typename AlignedPtr>
         requires(AlignedPtr::get_access_alignment(byte_offset) % atomic_access::alignment == 0)
         static void write(AlignedPtr dest, typename atomic_access::type value)
         {
-            dest.template dereference<typename atomic_access::type, byte_offset>() = value;
+            dest.template store<typename atomic_access::type, byte_offset>(value);
         }
     };
 
@@ -155,10 +156,10 @@ namespace netser
                 return access::template read<range.begin()>(src);
             }
 
-            template <typename T>
-            static void write(const void *src, T value)
+            template <typename AAlignedPtr>
+            static void write(AAlignedPtr dest, type value)
             {
-                access::template write<range.begin()>(src, value);
+                access::template write<range.begin()>(dest, value);
             }
         };
 
@@ -0,0 +1,212 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_OPTIONAL_FIELD_HPP__
+#define NETSER_OPTIONAL_FIELD_HPP__
+
+#include <netser/field.hpp>
+#include <netser/fill_random.hpp>
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/write.hpp>
+#include <netser/zipped.hpp>
+#include <optional>
+#include <type_traits>
+
+// Fields whose presence is controlled by earlier fields.
+// The predicate is evaluated on the host object once the fields before the optional_field have been read (or before writing):
+//
+//     struct sync_message {
+//         uint8_t flags;
+//         uint64_t timestamp;
+//         std::optional<uint32_t> extension;
+//     };
+//
+//     using sync_zipped = zipped<net_uint8, mem<&sync_message::flags>, net_uint64, mem<&sync_message::timestamp>,
+//                                optional_field<flag_set<&sync_message::flags, 0x04>, net_uint32>, mem<&sync_message::extension>>;
+//
+// The generated code branches once on the predicate. Each branch reads the optional part (if present) and all fields behind it with
+// static plans at static offsets, so both keep the full alignment. Only the pointer returned behind the layout has the residue class
+// both branches have in common.
+namespace netser
+{
+
+    // flag_set
+    // Predicate that is true iff any bit of Mask is set in the host member Member.
+    template <auto Member, auto Mask>
+    requires(concepts::MemberPtr<Member>)
+    struct flag_set
+    {
+        template <typename Host>
+        constexpr bool operator()(const Host &host) const
+        {
+            return (host.*Member & Mask) != 0;
+        }
+    };
+
+    namespace detail
+    {
+
+        template <typename T>
+        constexpr bool is_std_optional_v = false;
+
+        template <typename T>
+        constexpr bool is_std_optional_v<std::optional<T>> = true;
+
+        // optional_body
+        // Layout and mapping of the optional part. Plain layouts map onto the value itself.
+        template <typename Layout>
+        struct optional_body
+        {
+            using layout = netser::layout<Layout>;
+            using mapping = mapping_list<identity_member>;
+        };
+
+        template <typename... Args>
+        struct optional_body<zipped<Args...>>
+        {
+            using layout = typename zipped<Args...>::layout;
+            using mapping = typename zipped<Args...>::mapping;
+        };
+
+    } // namespace detail
+
+    // optional_field
+    // Layout is present iff Predicate{}(host) is true, where host is the object that is read or written. The mapping must dereference
+    // to a std::optional, which is reset if the field is absent, or to the value itself, which is then left untouched. Layout is either
+    // a layout node mapped onto the value or a zipped.
+    template <typename Predicate, typename Layout>
+    struct optional_field : public detail::simple_field_layout_mixin<optional_field<Predicate, Layout>>
+    {
+        using body = detail::optional_body<Layout>;
+
+        static_assert(layout_size_v<typename body::layout> % 8 == 0, "Optional fields must span whole bytes.");
+        static_assert(!layout_is_dynamic_v<typename body::layout>, "Optional fields must have a static size.");
+
+        static constexpr size_t body_bytes = layout_size_v<typename body::layout> / 8;
+
+        // No static extent, the body is skipped by transform_buffer if present.
+        static constexpr size_t size = 0;
+        static constexpr size_t count = 1;
+        static constexpr size_t num_children = 0;
+        static constexpr bool is_dynamic = true;
+
+        using detail::simple_field_layout_mixin<optional_field>::transform_buffer;
+
+        // transform_buffer
+        // Moves the buffer behind the body if it is present.
+        template <typename AlignedPtrType, bool Present>
+        static auto transform_buffer(AlignedPtrType ptr, std::bool_constant<Present>)
+        {
+            if constexpr (Present)
+            {
+                return ptr.template static_offset<int(body_bytes)>();
+            }
+            else
+            {
+                return ptr;
+            }
+        }
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto read_span(ZipIterator it)
+        {
+            constexpr size_t offset = ZipIterator::layout_iterator::get_offset();
+            static_assert(offset % 8 == 0, "Optional fields must be aligned to byte boundaries.");
+
+            using present_end = decltype(detail::read_zip_iterator(it.advance_dynamic(std::true_type{})));
+            using absent_end = decltype(detail::read_zip_iterator(it.advance_dynamic(std::false_type{})));
+            constexpr size_t end_alignment = common_alignment_v<present_end, absent_end>;
+
+            auto &&target = *it.mapping();
+            if (Predicate{}(it.mapping().arg_))
+            {
+                if constexpr (detail::is_std_optional_v<std::remove_cvref_t<decltype(target)>>)
+                {
+                    read_inline<typename body::layout, typename body::mapping>(it.layout().get().template static_offset<offset / 8>(),
+                                                                               target.emplace());
+                }
+                else
+                {
+                    read_inline<typename body::layout, typename body::mapping>(it.layout().get().template static_offset<offset / 8>(),
+                                                                               target);
+                }
+
+                return detail::read_zip_iterator(it.advance_dynamic(std::true_type{})).template weaken<end_alignment>();
+            }
+            else
+            {
+                if constexpr (detail::is_std_optional_v<std::remove_cvref_t<decltype(target)>>)
+                {
+                    target.reset();
+                }
+
+                return detail::read_zip_iterator(it.advance_dynamic(std::false_type{})).template weaken<end_alignment>();
+            }
+        }
+
+        // An empty std::optional is written as a value initialized body if the predicate requires the field.
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto write_span(ZipIterator it)
+        {
+            constexpr size_t offset = ZipIterator::layout_iterator::get_offset();
+            static_assert(offset % 8 == 0, "Optional fields must be aligned to byte boundaries.");
+
+            using present_end = decltype(detail::write_zip_iterator(it.advance_dynamic(std::true_type{})));
+            using absent_end = decltype(detail::write_zip_iterator(it.advance_dynamic(std::false_type{})));
+            constexpr size_t end_alignment = common_alignment_v<present_end, absent_end>;
+
+            const auto &target = *it.mapping();
+            if (Predicate{}(it.mapping().arg_))
+            {
+                if constexpr (detail::is_std_optional_v<std::remove_cvref_t<decltype(target)>>)
+                {
+                    using value_type = typename std::remove_cvref_t<decltype(target)>::value_type;
+                    write_inline<typename body::layout, typename body::mapping>(it.layout().get().template static_offset<offset / 8>(),
+                                                                                target ? *target : value_type{});
+                }
+                else
+                {
+                    write_inline<typename body::layout, typename body::mapping>(it.layout().get().template static_offset<offset / 8>(),
+                                                                                target);
+                }
+
+                return detail::write_zip_iterator(it.advance_dynamic(std::true_type{})).template weaken<end_alignment>();
+            }
+            else
+            {
+                return detail::write_zip_iterator(it.advance_dynamic(std::false_type{})).template weaken<end_alignment>();
+            }
+        }
+
+        // The predicate sees the host object as it is at that point, so the fields it depends on are filled before.
+        template <typename MappingIterator, typename Generator>
+        static NETSER_FORCE_INLINE void fill_random(MappingIterator it, Generator &&generator)
+        {
+            auto &&target = *it;
+            if constexpr (detail::is_std_optional_v<std::remove_cvref_t<decltype(target)>>)
+            {
+                if (Predicate{}(it.arg_))
+                {
+                    ::netser::fill_mapping_random<layout_enumerator_t<typename body::layout>>(
+                        make_mapping_iterator<typename body::mapping>(target.emplace()), std::forward<Generator>(generator));
+                }
+                else
+                {
+                    target.reset();
+                }
+            }
+            else if (Predicate{}(it.arg_))
+            {
+                ::netser::fill_mapping_random<layout_enumerator_t<typename body::layout>>(
+                    make_mapping_iterator<typename body::mapping>(target), std::forward<Generator>(generator));
+            }
+        }
+    };
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,195 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_PACKET_TEMPLATE_HPP__
+#define NETSER_PACKET_TEMPLATE_HPP__
+
+#include <netser/aligned_ptr.hpp>
+#include <netser/layout.hpp>
+#include <netser/projection.hpp>
+#include <netser/reserved.hpp>
+#include <netser/write.hpp>
+#include <netser/zipped.hpp>
+#include <array>
+#include <cstddef>
+
+// Pre-encoded packets.
+// Messages that are sent over and over again mostly repeat themselves: reserved fields, constants, version and domain. A packet
+// template encodes all fields once, each send copies the encoded image around the spans of the variable members and writes those:
+//
+//     packet_template<sync_zipped, &Sync::sequence_id, &Sync::origin_timestamp> sync_template(prototype);
+//
+//     prototype.sequence_id = next_sequence++;
+//     sync_template.encode(make_aligned_ptr<8>(frame), prototype);
+//
+// Every byte is stored once. The copies of the runs between the variable spans compile into a few wide stores. Fields that share a byte
+// with a variable member are written along from the message, constants (and reserved<>) among them from their mapping, so their bits
+// end up in the same stores as the variable members.
+namespace netser
+{
+
+    namespace detail
+    {
+
+        // variable_leaves
+        // Leaves that are written on each send: the selected ones, grown by all leaves sharing a byte with them until nothing changes.
+        // Each group of variable leaves then covers whole bytes.
+        template <size_t N>
+        constexpr std::array<bool, N> variable_leaves(std::array<bool, N> variable, const std::array<size_t, N> &begin,
+                                                      const std::array<size_t, N> &end)
+        {
+            for (bool grown = true; grown;)
+            {
+                grown = false;
+                for (size_t i = 0; i < N; ++i)
+                {
+                    for (size_t j = 0; j < N && !variable[i]; ++j)
+                    {
+                        if (variable[j] && end[i] > begin[i] && begin[i] / 8 < (end[j] + 7) / 8 && begin[j] / 8 < (end[i] + 7) / 8)
+                        {
+                            variable[i] = true;
+                            grown = true;
+                        }
+                    }
+                }
+            }
+            return rebuilt_selection(variable);
+        }
+
+        // image_bytes
+        // Bytes that no variable leaf touches, they are copied from the image.
+        template <size_t Bytes, size_t N>
+        constexpr std::array<bool, Bytes> image_bytes(const std::array<bool, N> &variable, const std::array<size_t, N> &begin,
+                                                      const std::array<size_t, N> &end)
+        {
+            std::array<bool, Bytes> image{};
+            image.fill(true);
+            for (size_t i = 0; i < N; ++i)
+            {
+                for (size_t byte = begin[i] / 8; variable[i] && byte < (end[i] + 7) / 8; ++byte)
+                {
+                    image[byte] = false;
+                }
+            }
+            return image;
+        }
+
+        template <typename Zipped, auto... MemberPtrs>
+        struct template_plan
+        {
+            using layout = typename Zipped::layout;
+
+            static_assert(!layout_is_dynamic_v<layout>, "Packet templates need a layout of static size.");
+            static_assert(layout_size_v<layout> % 8 == 0, "Layout must span whole bytes.");
+
+            using flat = flatten_zipped<layout_enumerator_t<layout>, mapping_range_t<typename Zipped::mapping>>;
+            using selection = member_selection<MemberPtrs...>;
+
+            static constexpr size_t leaf_count = leaf_count_v<layout>;
+            static constexpr size_t bytes = layout_size_v<layout> / 8;
+
+            static_assert(meta::type_list::size<typename flat::mappings> == leaf_count, "Every leaf must be mapped.");
+            static_assert((selection::template is_mapped<MemberPtrs, typename flat::mappings>(std::make_index_sequence<leaf_count>()) && ...),
+                          "A variable member is not mapped by the zipped layout.");
+
+            static constexpr std::array<bool, leaf_count> variable
+                = variable_leaves<leaf_count>(selection::template flags<typename flat::mappings>(std::make_index_sequence<leaf_count>()),
+                                              leaf_bits<layout, leaf_count>().first, leaf_bits<layout, leaf_count>().second);
+
+            static constexpr std::array<bool, bytes> image
+                = image_bytes<bytes, leaf_count>(variable, leaf_bits<layout, leaf_count>().first, leaf_bits<layout, leaf_count>().second);
+
+            using variable_layout = select_leaves_t<layout, variable>;
+
+            // image_run_end
+            // End of the run of image bytes starting at Begin.
+            static constexpr size_t image_run_end(size_t begin)
+            {
+                while (begin < bytes && image[begin])
+                {
+                    ++begin;
+                }
+                return begin;
+            }
+        };
+
+    } // namespace detail
+
+    // packet_template< Zipped, &Struct::member... >
+    // Encoded image of Zipped with the given members marked as variable, see above.
+    template <concepts::Zipped Zipped, auto... VariableMembers>
+    requires((concepts::MemberPtr<VariableMembers> && ...))
+    class packet_template
+    {
+        using plan = detail::template_plan<Zipped, VariableMembers...>;
+
+      public:
+        static constexpr size_t bytes = plan::bytes;
+
+        // The image starts out with all fields zero.
+        packet_template() = default;
+
+        template <typename Src>
+        explicit packet_template(const Src &prototype)
+        {
+            update(prototype);
+        }
+
+        // update( prototype : const Src& )
+        // Encodes all fields of prototype into the image. Call it when a rarely changing field changes.
+        template <typename Src>
+        void update(const Src &prototype)
+        {
+            write_zipped_inline<Zipped>(image_pointer(), prototype);
+        }
+
+        // encode( dest : aligned_ptr<>, msg : const Src& )
+        // Writes the image around the variable spans to dest and the variable fields of msg into them.
+        template <typename AlignedPtr, typename Src>
+        NETSER_FORCE_INLINE void encode(AlignedPtr dest, const Src &msg) const
+        {
+            store_image_runs<0>(dest);
+            write_inline<typename plan::variable_layout, typename Zipped::mapping>(dest, msg);
+        }
+
+        // image
+        // The encoded constant part.
+        const unsigned char *image() const
+        {
+            return image_;
+        }
+
+      private:
+        // store_image_runs
+        // Copies the runs of image bytes starting at or behind byte Begin.
+        template <size_t Begin, typename AlignedPtr>
+        NETSER_FORCE_INLINE void store_image_runs(AlignedPtr dest) const
+        {
+            if constexpr (Begin < bytes)
+            {
+                constexpr size_t end = plan::image_run_end(Begin);
+                if constexpr (end > Begin)
+                {
+                    dest.template store_bytes<end - Begin, int(Begin)>(image_ + Begin);
+                    store_image_runs<end>(dest);
+                }
+                else
+                {
+                    store_image_runs<Begin + 1>(dest);
+                }
+            }
+        }
+
+        auto image_pointer()
+        {
+            return aligned_ptr<unsigned char, detail::staging_alignment, 0, bounded<0, int(bytes) + 1>>(image_);
+        }
+
+        alignas(detail::staging_alignment) unsigned char image_[bytes] = {};
+    };
+
+} // namespace netser
+
+#endif
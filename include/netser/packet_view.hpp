@@ -0,0 +1,132 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_PACKET_VIEW_HPP__
+#define NETSER_PACKET_VIEW_HPP__
+
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/zip_iterator.hpp>
+#include <netser/zipped.hpp>
+#include <type_traits>
+
+namespace netser
+{
+
+    namespace detail
+    {
+
+        // locate_member
+        // Walks the leaves of a layout and its mapping side by side and returns the field that is mapped onto MemberPtr together with
+        // its bit offset inside the layout.
+        template <auto MemberPtr, typename LayoutIt, typename MappingIt,
+                  bool IsEnd = meta::concepts::EmptyRange<LayoutIt> || meta::concepts::Sentinel<MappingIt>>
+        struct locate_member
+        {
+            using placed = meta::dereference_t<LayoutIt>;
+            using next = locate_member<MemberPtr, meta::advance_t<LayoutIt>, meta::advance_t<MappingIt>>;
+
+            static constexpr bool found = same_member_v<meta::dereference_t<MappingIt>, MemberPtr>;
+
+            using field = std::conditional_t<found, typename placed::field, typename next::field>;
+            static constexpr size_t offset = found ? placed::offset : next::offset;
+        };
+
+        template <auto MemberPtr, typename LayoutIt, typename MappingIt>
+        struct locate_member<MemberPtr, LayoutIt, MappingIt, true>
+        {
+            using field = void;
+            static constexpr size_t offset = 0;
+        };
+
+        template <typename Zipped, auto MemberPtr>
+        struct zipped_member_field
+            : public locate_member<MemberPtr, layout_enumerator_t<typename Zipped::layout>, mapping_range_t<typename Zipped::mapping>>
+        {
+            static_assert(!std::is_void_v<typename zipped_member_field::field>, "Member is not mapped by the zipped layout.");
+        };
+
+        // single_field_iterator
+        // Layout iterator over just Field, placed BitOffset bits behind ptr.
+        template <typename Field, size_t BitOffset, typename AlignedPtr>
+        NETSER_FORCE_INLINE auto make_single_field_iterator(AlignedPtr ptr)
+        {
+            using range = layout_meta_iterator<meta::tree_begin<layout<Field>, layout_tree_ctx, meta::traversals::lr>, BitOffset % 8>;
+            using ptr_type = typename AlignedPtr::template static_offset_t<int(BitOffset / 8)>;
+            return layout_iterator<ptr_type, range>(ptr.template static_offset<int(BitOffset / 8)>());
+        }
+
+        // read_single_field
+        // Runs the access plan of one field at a static bit offset.
+        template <typename Field, size_t BitOffset, typename AlignedPtr, typename Dest>
+        NETSER_FORCE_INLINE void read_single_field(AlignedPtr ptr, Dest &dest)
+        {
+            auto it = make_zip_iterator(make_single_field_iterator<Field, BitOffset>(ptr), make_mapping_iterator<mapping_list<identity>>(dest));
+            meta::dereference_t<typename decltype(it)::layout_iterator>::read_span(it);
+        }
+
+    } // namespace detail
+
+    // packet_view
+    // Non-owning view on an encoded packet of the zipped layout Zipped. Nothing is decoded up front, get<&Struct::member>() runs the
+    // access plan of just that member's field at its static offset, set<&Struct::member>(value) patches just that field.
+    template <concepts::Zipped Zipped, typename AlignedPtr>
+    class packet_view
+    {
+      public:
+        using zipped_type = Zipped;
+        using pointer_type = AlignedPtr;
+
+        constexpr explicit packet_view(AlignedPtr ptr) : ptr_(ptr)
+        {
+        }
+
+        // get
+        // Decodes the field mapped onto MemberPtr.
+        template <auto MemberPtr>
+        requires(concepts::MemberPtr<MemberPtr>)
+        NETSER_FORCE_INLINE auto get() const
+        {
+            using located = detail::zipped_member_field<Zipped, MemberPtr>;
+
+            typename member_object_pointer_traits<MemberPtr>::value_type result{};
+            detail::read_single_field<typename located::field, located::offset>(ptr_, result);
+            return result;
+        }
+
+        // set
+        // Encodes value into the integer field mapped onto MemberPtr, leaving all other bits of the packet untouched.
+        template <auto MemberPtr, typename Value>
+        requires(concepts::MemberPtr<MemberPtr>)
+        NETSER_FORCE_INLINE void set(Value value) const
+        {
+            using located = detail::zipped_member_field<Zipped, MemberPtr>;
+            using field = typename located::field;
+            static_assert(is_integer_v<field>, "Only integer fields can be set in place.");
+            static_assert(!std::is_const_v<typename AlignedPtr::value_type>, "Cannot set a field through a view on a const buffer.");
+
+            detail::set_integer_algorithm::set<field, int(located::offset % 8), int(located::offset % 8 + field::size)>(
+                ptr_.template static_offset<int(located::offset / 8)>(), static_cast<typename field::stage_type>(value));
+        }
+
+        constexpr AlignedPtr pointer() const
+        {
+            return ptr_;
+        }
+
+      private:
+        AlignedPtr ptr_;
+    };
+
+    template <concepts::Zipped Zipped, typename AlignedPtr>
+    constexpr auto make_packet_view(AlignedPtr ptr)
+    {
+        return packet_view<Zipped, AlignedPtr>(ptr);
+    }
+
+} // namespace netser
+
+#endif
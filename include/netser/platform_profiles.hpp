@@ -0,0 +1,53 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_PLATFORM_PROFILES_HPP__
+#define NETSER_PLATFORM_PROFILES_HPP__
+
+#include <netser/mem_access.hpp>
+#include <meta/tlist.hpp>
+
+// Ready-made memory access lists to be used as platform_memory_accesses inside netser_config.hpp:
+//
+//     using platform_memory_accesses = profiles::unaligned_little_endian;
+//
+namespace netser
+{
+    namespace profiles
+    {
+
+        // strict_little_endian
+        // Every access must be naturally aligned (Cortex-M0, older ARM cores, most DSPs).
+        using strict_little_endian = meta::tlist<
+            atomic_memory_access<unsigned char, 1, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned short, 2, 2, byte_order::little_endian>,
+            atomic_memory_access<unsigned int, 4, 4, byte_order::little_endian>,
+            atomic_memory_access<unsigned long long, 8, 8, byte_order::little_endian>
+        >;
+
+        // unaligned_little_endian
+        // Every access may start at any offset (x86-64, AArch64). Accesses below natural alignment are copied through
+        // aligned_ptr::load/store, so the planners will pick a single 8 byte access for a 64 bit field at any offset.
+        using unaligned_little_endian = meta::tlist<
+            atomic_memory_access<unsigned char, 1, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned short, 2, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned int, 4, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned long long, 8, 1, byte_order::little_endian>
+        >;
+
+        // cortex_m7
+        // Half-word and word accesses may be unaligned, double-word accesses (LDRD/STRD) must be word aligned.
+        using cortex_m7 = meta::tlist<
+            atomic_memory_access<unsigned char, 1, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned short, 2, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned int, 4, 1, byte_order::little_endian>,
+            atomic_memory_access<unsigned long long, 8, 4, byte_order::little_endian>
+        >;
+
+    } // namespace profiles
+
+} // namespace netser
+
+#endif
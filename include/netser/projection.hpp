@@ -0,0 +1,164 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_PROJECTION_HPP__
+#define NETSER_PROJECTION_HPP__
+
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/reserved.hpp>
+#include <netser/zipped.hpp>
+#include <array>
+#include <utility>
+
+namespace netser
+{
+
+    namespace detail
+    {
+
+        // flatten_zipped
+        // Leaves of a layout (unplaced fields) and the mapping leaves paired with them as two flat lists.
+        template <typename LayoutIt, typename MappingIt, typename Fields = meta::tlist<>, typename Mappings = meta::tlist<>,
+                  bool IsEnd = meta::concepts::EmptyRange<LayoutIt> || meta::concepts::Sentinel<MappingIt>>
+        struct flatten_zipped
+            : public flatten_zipped<meta::advance_t<LayoutIt>, meta::advance_t<MappingIt>,
+                                    meta::type_list::push_back<Fields, typename meta::dereference_t<LayoutIt>::field>,
+                                    meta::type_list::push_back<Mappings, meta::dereference_t<MappingIt>>>
+        {
+        };
+
+        template <typename LayoutIt, typename MappingIt, typename Fields, typename Mappings>
+        struct flatten_zipped<LayoutIt, MappingIt, Fields, Mappings, true>
+        {
+            using fields = Fields;
+            using mappings = Mappings;
+        };
+
+        enum class projected
+        {
+            skip,    // no access
+            keep,    // decoded into the destination
+            discard  // integer between two kept fields of a span, read along but not stored
+        };
+
+        // project_fields
+        // A field is kept if it is mapped onto one of the selected members. Unselected integers that lie between two kept integers of
+        // the same span are read along, so the kept fields can still share their loads. Everything else is skipped.
+        template <size_t N>
+        constexpr std::array<projected, N> project_fields(const std::array<bool, N> &integer, const std::array<bool, N> &selected)
+        {
+            std::array<projected, N> result{};
+            for (size_t i = 0; i < N; ++i)
+            {
+                if (selected[i])
+                {
+                    result[i] = projected::keep;
+                }
+                else if (integer[i])
+                {
+                    size_t before = i;
+                    while (before > 0 && integer[before - 1] && !selected[before - 1])
+                        --before;
+                    size_t after = i + 1;
+                    while (after < N && integer[after] && !selected[after])
+                        ++after;
+
+                    const bool kept_before = before > 0 && integer[before - 1] && selected[before - 1];
+                    const bool kept_after = after < N && integer[after] && selected[after];
+                    result[i] = (kept_before && kept_after) ? projected::discard : projected::skip;
+                }
+                else
+                {
+                    result[i] = projected::skip;
+                }
+            }
+            return result;
+        }
+
+        template <typename Fields, size_t... Index>
+        constexpr std::array<bool, sizeof...(Index)> integer_flags(std::index_sequence<Index...>)
+        {
+            return {is_integer_v<meta::type_list::get<Fields, Index>>...};
+        }
+
+        template <auto... MemberPtrs>
+        struct member_selection
+        {
+            template <typename Mapping>
+            static constexpr bool contains = (same_member_v<Mapping, MemberPtrs> || ...);
+
+            template <typename Mappings, size_t... Index>
+            static constexpr std::array<bool, sizeof...(Index)> flags(std::index_sequence<Index...>)
+            {
+                return {contains<meta::type_list::get<Mappings, Index>>...};
+            }
+
+            // true iff MemberPtr is mapped by one of the Mappings
+            template <auto MemberPtr, typename Mappings, size_t... Index>
+            static constexpr bool is_mapped(std::index_sequence<Index...>)
+            {
+                return (same_member_v<meta::type_list::get<Mappings, Index>, MemberPtr> || ...);
+            }
+        };
+
+        template <typename Zipped, auto... MemberPtrs>
+        struct projection
+        {
+            using flat = flatten_zipped<layout_enumerator_t<typename Zipped::layout>, mapping_range_t<typename Zipped::mapping>>;
+            using selection = member_selection<MemberPtrs...>;
+            static constexpr size_t count = meta::type_list::size<typename flat::fields>;
+
+            static constexpr std::array<projected, count> decisions
+                = project_fields<count>(integer_flags<typename flat::fields>(std::make_index_sequence<count>()),
+                                        selection::template flags<typename flat::mappings>(std::make_index_sequence<count>()));
+
+            static constexpr bool all_mapped
+                = (selection::template is_mapped<MemberPtrs, typename flat::mappings>(std::make_index_sequence<count>()) && ...);
+
+            template <size_t Index, typename Field = meta::type_list::get<typename flat::fields, Index>>
+            using layout_element = std::conditional_t<decisions[Index] == projected::skip, skip<Field::size>, Field>;
+
+            template <size_t Index, typename Mapping = meta::type_list::get<typename flat::mappings, Index>>
+            using mapping_element = std::conditional_t<decisions[Index] == projected::keep, Mapping, constant<size_t, 0>>;
+
+            template <size_t... Index>
+            static auto make_layout(std::index_sequence<Index...>) -> netser::layout<layout_element<Index>...>;
+
+            template <size_t... Index>
+            static auto make_mapping(std::index_sequence<Index...>) -> mapping_list<mapping_element<Index>...>;
+
+            using layout = decltype(make_layout(std::make_index_sequence<count>()));
+            using mapping = decltype(make_mapping(std::make_index_sequence<count>()));
+        };
+
+    } // namespace detail
+
+    // read_zipped_only< Zipped, &Struct::member... >( source : aligned_ptr<>, dest : Struct& )
+    // Reads only the fields mapped onto the given members of dest. The members must be direct members of dest, all other members
+    // are left untouched and no accesses are generated for fields that are not needed.
+    template <concepts::Zipped Zipped, auto... MemberPtrs, typename AlignedPtr, typename Dest>
+    requires((concepts::MemberPtr<MemberPtrs> && ...))
+    auto read_zipped_only(AlignedPtr src, Dest &dest)
+    {
+        using projection = detail::projection<Zipped, MemberPtrs...>;
+        static_assert(projection::all_mapped, "A selected member is not mapped by the zipped layout.");
+
+        return read_inline<typename projection::layout, typename projection::mapping>(src, dest);
+    }
+
+    // read_only< &Struct::member... >( source : aligned_ptr<>, dest : Struct& )
+    // read_zipped_only using the default_zipped of Struct.
+    template <auto... MemberPtrs, typename AlignedPtr, typename Dest>
+    requires((concepts::MemberPtr<MemberPtrs> && ...))
+    auto read_only(AlignedPtr src, Dest &dest)
+    {
+        return read_zipped_only<default_zipped_t<Dest &>, MemberPtrs...>(src, dest);
+    }
+
+} // namespace netser
+
+#endif
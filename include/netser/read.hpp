@@ -8,6 +8,8 @@
 
 #include <netser/platform.hpp>
 #include <netser/layout.hpp>
+#include <netser/field.hpp>
+#include <netser/zip_iterator.hpp>
 #include <type_traits>
 
 namespace netser
@@ -23,7 +25,15 @@ namespace netser
             {
                 using type = decltype(meta::dereference_t<typename ZipIterator::layout_iterator>::read_span(it));
                 auto result = meta::dereference_t<typename ZipIterator::layout_iterator>::read_span(it);
-                return read_zip_iterator_struct<type>::read(result);
+                if constexpr (is_zip_iterator_v<type>)
+                {
+                    return read_zip_iterator_struct<type>::read(result);
+                }
+                else
+                {
+                    // The field has read the rest of the layout itself and returned the pointer behind it (see optional_field).
+                    return result;
+                }
             }
         };
 
@@ -73,32 +83,59 @@ namespace netser
 
     } // namespace detail
 
+    template <typename Layout, typename Mapping, typename AlignedPtr, typename Arg>
+    NETSER_FORCE_INLINE auto read_inline(AlignedPtr ptr, Arg &&dest);
+
+    namespace detail
+    {
+
+        // read_staged
+        // Bulk copy of the whole layout into an aligned local buffer, then the usual read from there (see staged_reads).
+        template <typename Layout, typename Mapping, typename AlignedPtr, typename Arg>
+        NETSER_FORCE_INLINE auto read_staged(AlignedPtr ptr, Arg &&dest)
+        {
+            constexpr size_t bytes = layout_size_v<Layout> / 8;
+            constexpr size_t stage_bytes = (bytes + staging_alignment - 1) / staging_alignment * staging_alignment;
+
+            alignas(staging_alignment) unsigned char stage[stage_bytes] = {};
+            ptr.template load_bytes<bytes>(stage);
+
+            read_inline<Layout, Mapping>(aligned_ptr<unsigned char, staging_alignment, 0, bounded<0, int(stage_bytes) + 1>>(stage),
+                                         std::forward<Arg>(dest));
+
+            // return a pointer one behind the layout (for continuation)
+            return ptr.template static_offset<int(bytes)>();
+        }
+
+    } // namespace detail
+
     // read< Layout, Mapping >( source : aligned_ptr<>, dest : Dest& )
     //
     //
     template <typename Layout, typename Mapping, typename AlignedPtr, typename Arg>
     void read(AlignedPtr ptr, Arg &&dest)
     {
-        detail::read_zip_iterator(
-            make_zip_iterator(
-                make_layout_iterator<Layout>(ptr),
-                make_mapping_iterator<Mapping>(std::forward<Arg>(dest))
-                )
-            );
+        read_inline<Layout, Mapping>(ptr, std::forward<Arg>(dest));
     }
 
-    // read< Layout, Mapping >( source : aligned_ptr<>, dest : Dest& )
-    //
-    //
+    // read_inline< Layout, Mapping >( source : aligned_ptr<>, dest : Dest& )
+    // Small layouts may be read through a staging buffer (see staged_reads), so every entry point (read_zipped, operator>>) gets it.
     template <typename Layout, typename Mapping, typename AlignedPtr, typename Arg>
     NETSER_FORCE_INLINE auto read_inline(AlignedPtr ptr, Arg &&dest)
     {
-        return detail::read_zip_iterator(
-            make_zip_iterator(
-                make_layout_iterator<Layout>(ptr),
-                make_mapping_iterator<Mapping>(std::forward<Arg>(dest))
-                )
-            );
+        if constexpr (!layout_is_dynamic_v<Layout> && detail::prefer_staged_read_v<AlignedPtr, layout_size_v<Layout>>)
+        {
+            return detail::read_staged<Layout, Mapping>(ptr, std::forward<Arg>(dest));
+        }
+        else
+        {
+            return detail::read_zip_iterator(
+                make_zip_iterator(
+                    make_layout_iterator<Layout>(ptr),
+                    make_mapping_iterator<Mapping>(std::forward<Arg>(dest))
+                    )
+                );
+        }
     }
 
 } // namespace netser
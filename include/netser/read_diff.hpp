@@ -0,0 +1,181 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_READ_DIFF_HPP__
+#define NETSER_READ_DIFF_HPP__
+
+#include <netser/layout.hpp>
+#include <netser/read.hpp>
+#include <netser/reserved.hpp>
+#include <netser/write_dirty.hpp>
+#include <netser/zipped.hpp>
+#include <cstddef>
+#include <cstring>
+
+// Change detecting reads.
+// Polling the same block over and over mostly yields the same bytes. read_diff keeps a copy of the bytes seen last time and compares each
+// group of fields before decoding it. A group is the smallest run of fields (see dirty_plan) that ends on a byte boundary, most often
+// a single field:
+//
+//     shadow_image<status_zipped> shadow;
+//     status_block status;
+//
+//     auto changed = read_diff<status_zipped>(make_aligned_ptr<8>(block), status, shadow);
+//     if ((changed & make_dirty_mask<status_zipped, &status_block::alarms>()).any()) { ... }
+//
+// An unchanged group costs a fixed-size compare of its bytes, which compiles into a few word compares, and no field is decoded. Changed
+// groups are decoded with their usual plan and each field is compared on its bits, so a change in one field of a long run of integers
+// decodes only that field.
+namespace netser
+{
+
+    // shadow_image< Zipped >
+    // Bytes of the last packet read by read_diff. dest keeps the fields decoded from them, so a shadow belongs to one destination object.
+    template <concepts::Zipped Zipped>
+    class shadow_image
+    {
+      public:
+        static_assert(layout_size_v<typename Zipped::layout> % 8 == 0, "Layout must span whole bytes.");
+        static constexpr size_t bytes = layout_size_v<typename Zipped::layout> / 8;
+
+        // reset
+        // Forgets the last packet, the next read_diff decodes everything.
+        void reset()
+        {
+            primed_ = false;
+        }
+
+        bool primed() const
+        {
+            return primed_;
+        }
+
+        void set_primed()
+        {
+            primed_ = true;
+        }
+
+        unsigned char *data()
+        {
+            return bytes_;
+        }
+
+        const unsigned char *data() const
+        {
+            return bytes_;
+        }
+
+      private:
+        unsigned char bytes_[bytes] = {};
+        bool primed_ = false;
+    };
+
+    namespace detail
+    {
+
+        // bits_differ
+        // true iff the bits [Begin, End) (counted from the most significant bit of the first byte) of a and b differ.
+        template <size_t Begin, size_t End>
+        NETSER_FORCE_INLINE bool bits_differ(const unsigned char *a, const unsigned char *b)
+        {
+            unsigned char diff = 0;
+            for (size_t byte = Begin / 8; byte < (End + 7) / 8; ++byte)
+            {
+                unsigned mask = 0xff;
+                if (byte == Begin / 8)
+                    mask &= 0xffu >> (Begin % 8);
+                if (byte == (End - 1) / 8 && End % 8 != 0)
+                    mask &= 0xffu << (8 - End % 8);
+                diff |= static_cast<unsigned char>((a[byte] ^ b[byte]) & mask);
+            }
+            return diff != 0;
+        }
+
+        template <typename Plan, size_t First, size_t Last, size_t BaseBits, typename Mask>
+        NETSER_FORCE_INLINE void mark_changed_fields(const unsigned char *current, const unsigned char *previous, Mask &changed)
+        {
+            if constexpr (First < Last)
+            {
+                changed[First] = bits_differ<Plan::leaf_begin[First] - BaseBits, Plan::leaf_end[First] - BaseBits>(current, previous);
+                mark_changed_fields<Plan, First + 1, Last, BaseBits>(current, previous, changed);
+            }
+        }
+
+        // diff_group_end
+        // One behind the last leaf of the group starting at leaf first: leaves of its run are added until one ends on a byte boundary.
+        template <typename Plan>
+        constexpr size_t diff_group_end(size_t first)
+        {
+            const size_t run_end = Plan::run_end(first);
+            size_t last = first + 1;
+            while (last < run_end && Plan::leaf_end[last - 1] % 8 != 0)
+                ++last;
+            return last;
+        }
+
+        // read_diff_groups
+        // Compares, and if needed decodes, the group starting at leaf First and all groups behind it. Returns true if any of their bytes
+        // differ from the shadow, which is left untouched since neighbouring groups may share a byte.
+        template <typename Zipped, size_t First, typename AlignedPtr, typename Dest, typename Mask>
+        NETSER_FORCE_INLINE bool read_diff_groups(AlignedPtr ptr, Dest &dest, const unsigned char *shadow, Mask &changed)
+        {
+            using plan = dirty_plan<typename Zipped::layout>;
+
+            if constexpr (First < plan::leaf_count)
+            {
+                constexpr size_t last = diff_group_end<plan>(First);
+                constexpr size_t begin_byte = plan::leaf_begin[First] / 8;
+                constexpr size_t end_byte = (plan::leaf_end[last - 1] + 7) / 8;
+
+                bool differs = false;
+                if constexpr (end_byte > begin_byte)
+                {
+                    const unsigned char *current = ptr.template byte_range<end_byte - begin_byte, int(begin_byte)>();
+                    differs = std::memcmp(current, shadow + begin_byte, end_byte - begin_byte) != 0;
+                    if (differs)
+                    {
+                        read_inline<select_leaves_t<typename Zipped::layout, plan::selection(First, last)>, typename Zipped::mapping>(ptr,
+                                                                                                                                       dest);
+                        mark_changed_fields<plan, First, last, begin_byte * 8>(current, shadow + begin_byte, changed);
+                    }
+                }
+
+                return read_diff_groups<Zipped, last>(ptr, dest, shadow, changed) | differs;
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+    } // namespace detail
+
+    // read_diff< Zipped >( source : aligned_ptr<>, dest : Dest&, shadow : shadow_image<Zipped>& )
+    // Brings dest up to date with source and returns the leaves whose bits changed since the last read_diff with shadow (all leaves on the
+    // first one). Test members with make_dirty_mask.
+    template <concepts::Zipped Zipped, typename AlignedPtr, typename Dest>
+    dirty_mask<Zipped> read_diff(AlignedPtr ptr, Dest &dest, shadow_image<Zipped> &shadow)
+    {
+        constexpr size_t bytes = shadow_image<Zipped>::bytes;
+
+        dirty_mask<Zipped> changed;
+        if (!shadow.primed())
+        {
+            read_zipped_inline<Zipped>(ptr, dest);
+            changed.set();
+        }
+        else if (!detail::read_diff_groups<Zipped, 0>(ptr, dest, shadow.data(), changed))
+        {
+            return changed;
+        }
+
+        std::memcpy(shadow.data(), ptr.template byte_range<bytes>(), bytes);
+        shadow.set_primed();
+        return changed;
+    }
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,108 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_RECORD_STREAM_HPP__
+#define NETSER_RECORD_STREAM_HPP__
+
+#include <netser/zipped.hpp>
+#include <span>
+#include <utility>
+
+namespace netser
+{
+
+    namespace detail
+    {
+
+        // One period of records. Record Phase of every period has the same residue class, so each phase gets its own plan.
+        // Checked: the last period may be incomplete.
+        template <typename Zipped, size_t Stride, bool Checked, typename AlignedPtr, typename Dest, size_t... Phase>
+        NETSER_FORCE_INLINE void read_record_period(AlignedPtr first, Dest *dest, size_t period_index, size_t count,
+                                                    std::index_sequence<Phase...>)
+        {
+            constexpr size_t period = sizeof...(Phase);
+            (((!Checked || period_index * period + Phase < count)
+                  ? (void) read_zipped_inline<Zipped>(first.template periodic_stride<Stride, Phase>(period_index),
+                                                      dest[period_index * period + Phase])
+                  : void()),
+             ...);
+        }
+
+        template <typename Zipped, size_t Stride, bool Checked, typename AlignedPtr, typename Src, size_t... Phase>
+        NETSER_FORCE_INLINE void write_record_period(AlignedPtr first, Src *src, size_t period_index, size_t count,
+                                                     std::index_sequence<Phase...>)
+        {
+            constexpr size_t period = sizeof...(Phase);
+            (((!Checked || period_index * period + Phase < count)
+                  ? (void) write_zipped_inline<Zipped>(first.template periodic_stride<Stride, Phase>(period_index),
+                                                       src[period_index * period + Phase])
+                  : void()),
+             ...);
+        }
+
+    } // namespace detail
+
+    // record_stream
+    // Back-to-back records of one zipped layout in a single buffer.
+    // The residue class of record i repeats every AlignedPtr::stride_period<record_bytes>() records, so instead of dropping to the
+    // alignment common to all records, the records are processed in periods with a specialized plan for every phase.
+    // F.e. 22 byte records in an 8 aligned buffer: period 4, with residues 0, 6, 4, 2.
+    template <concepts::Zipped Zipped>
+    struct record_stream
+    {
+        using layout = typename Zipped::layout;
+        using mapping = typename Zipped::mapping;
+
+        static_assert(layout_size_v<layout> % 8 == 0, "Records must end on a byte boundary.");
+        static constexpr size_t record_bytes = layout_size_v<layout> / 8;
+
+        // read( first : aligned_ptr<>, dest : span<Dest> )
+        // Reads dest.size() records starting at first. Returns a pointer one behind the last record (for continuation).
+        template <typename AlignedPtr, typename Dest>
+        static auto read(AlignedPtr first, std::span<Dest> dest)
+        {
+            constexpr size_t period = AlignedPtr::template stride_period<record_bytes>();
+            const size_t count = dest.size();
+            const size_t full_periods = count / period;
+
+            for (size_t p = 0; p < full_periods; ++p)
+            {
+                detail::read_record_period<Zipped, record_bytes, false>(first, dest.data(), p, count, std::make_index_sequence<period>());
+            }
+            if (full_periods * period != count)
+            {
+                detail::read_record_period<Zipped, record_bytes, true>(first, dest.data(), full_periods, count,
+                                                                       std::make_index_sequence<period>());
+            }
+
+            return first.template stride<record_bytes>(count);
+        }
+
+        // write( first : aligned_ptr<>, src : span<Src> )
+        // Writes src.size() records starting at first. Returns a pointer one behind the last record (for continuation).
+        template <typename AlignedPtr, typename Src>
+        static auto write(AlignedPtr first, std::span<Src> src)
+        {
+            constexpr size_t period = AlignedPtr::template stride_period<record_bytes>();
+            const size_t count = src.size();
+            const size_t full_periods = count / period;
+
+            for (size_t p = 0; p < full_periods; ++p)
+            {
+                detail::write_record_period<Zipped, record_bytes, false>(first, src.data(), p, count, std::make_index_sequence<period>());
+            }
+            if (full_periods * period != count)
+            {
+                detail::write_record_period<Zipped, record_bytes, true>(first, src.data(), full_periods, count,
+                                                                        std::make_index_sequence<period>());
+            }
+
+            return first.template stride<record_bytes>(count);
+        }
+    };
+
+} // namespace netser
+
+#endif
@@ -2,6 +2,9 @@
 #define NETSER_RESERVED_HPP___
 
 #include "layout.hpp"
+#include "field.hpp"
+#include <array>
+#include <utility>
 
 namespace netser {
 
@@ -14,6 +17,132 @@ namespace netser {
 
     static_assert(concepts::LayoutSpecifier<reserved<0>>);
 
+    // skip
+    // Leaf that covers Bits bits without any memory access on read or write. The mapping element paired with it is never touched.
+    // Used for fields that are left out of a read (see read_only).
+    template <size_t Bits>
+    struct skip : public detail::simple_field_layout_mixin<skip<Bits>>
+    {
+        static constexpr size_t size = Bits;
+        static constexpr size_t count = 1;
+
+        static constexpr size_t num_children = 0;
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto read_span(ZipIterator it)
+        {
+            return ++it;
+        }
+
+        template <typename ZipIterator>
+        static NETSER_FORCE_INLINE auto write_span(ZipIterator it)
+        {
+            return ++it;
+        }
+
+        template <typename MappingIterator, typename Generator>
+        static void fill_random(MappingIterator, Generator &&)
+        {
+        }
+    };
+
+    namespace detail
+    {
+
+        template <typename LayoutMetaIterator>
+        constexpr size_t count_leaves()
+        {
+            if constexpr (meta::concepts::EmptyRange<LayoutMetaIterator>)
+                return 0;
+            else
+                return 1 + count_leaves<meta::advance_t<LayoutMetaIterator>>();
+        }
+
+        template <typename LayoutMetaIterator, size_t N>
+        constexpr void collect_leaf_bits(std::array<size_t, N> &begin, std::array<size_t, N> &end, size_t index)
+        {
+            if constexpr (!meta::concepts::EmptyRange<LayoutMetaIterator>)
+            {
+                using placed = meta::dereference_t<LayoutMetaIterator>;
+                begin[index] = placed::offset;
+                end[index] = placed::offset + placed::field::size;
+                collect_leaf_bits<meta::advance_t<LayoutMetaIterator>>(begin, end, index + 1);
+            }
+        }
+
+        // leaf_bits
+        // Begin and end bit offsets of all leaves of Layout in layout order.
+        template <typename Layout, size_t LeafCount>
+        constexpr std::pair<std::array<size_t, LeafCount>, std::array<size_t, LeafCount>> leaf_bits()
+        {
+            std::array<size_t, LeafCount> begin{}, end{};
+            collect_leaf_bits<layout_enumerator_t<Layout>>(begin, end, 0);
+            return {begin, end};
+        }
+
+        template <typename Node>
+        constexpr size_t node_leaf_count()
+        {
+            if constexpr (Node::num_children == 0)
+                return 1;
+            else
+                return count_leaves<layout_enumerator_t<Node>>();
+        }
+
+        template <typename Node, size_t Index>
+        constexpr size_t child_leaf_offset()
+        {
+            if constexpr (Index == 0)
+                return 0;
+            else
+                return child_leaf_offset<Node, Index - 1>() + node_leaf_count<typename Node::template get_child<Index - 1>>();
+        }
+
+        template <typename Node, auto Selected, size_t FirstLeaf, bool IsLeaf = Node::num_children == 0>
+        struct select_leaves
+        {
+            using type = std::conditional_t<Selected[FirstLeaf], Node, skip<Node::size>>;
+        };
+
+        template <typename Node, auto Selected, size_t FirstLeaf>
+        struct select_leaves<Node, Selected, FirstLeaf, false>
+        {
+            template <size_t... Index>
+            static auto select(std::index_sequence<Index...>)
+                -> layout<typename select_leaves<typename Node::template get_child<Index>, Selected,
+                                                 FirstLeaf + child_leaf_offset<Node, Index>()>::type...>;
+
+            using type = decltype(select(std::make_index_sequence<Node::num_children>()));
+        };
+
+        template <size_t N, size_t... Index>
+        constexpr std::array<bool, N> rebuilt_selection(const std::array<bool, N> &selected, std::index_sequence<Index...>)
+        {
+            return {selected[Index]...};
+        }
+
+        // rebuilt_selection
+        // Element by element copy of a selection for select_leaves_t. GCC 12 mistakes selections that were filled in by a loop during
+        // constant evaluation for one another when they are used as template arguments, braced copies compare correctly.
+        template <size_t N>
+        constexpr std::array<bool, N> rebuilt_selection(const std::array<bool, N> &selected)
+        {
+            return rebuilt_selection(selected, std::make_index_sequence<N>());
+        }
+
+    } // namespace detail
+
+    // leaf_count_v
+    // Number of leaves of Layout.
+    template <typename Layout>
+    constexpr size_t leaf_count_v = detail::count_leaves<layout_enumerator_t<Layout>>();
+
+    // select_leaves_t< Layout, Selected >
+    // Layout with every leaf i for which Selected[i] (a std::array<bool, leaf_count_v<Layout>>) is false replaced by skip<>. The tree
+    // shape is kept, so the mapping of Layout pairs with the result, and skipped leaves generate no accesses.
+    template <typename Layout, auto Selected>
+    using select_leaves_t = typename detail::select_leaves<Layout, Selected, 0>::type;
+
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,379 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_SEGMENTS_HPP__
+#define NETSER_SEGMENTS_HPP__
+
+#include <netser/aligned_ptr.hpp>
+#include <netser/checked.hpp>
+#include <netser/layout.hpp>
+#include <netser/reserved.hpp>
+#include <netser/zipped.hpp>
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <utility>
+
+// Scatter-gather reads and writes.
+// A packet may be spread over several (pointer, length) segments, f.e. a header and a chained body buffer or a wrapping ring buffer:
+//
+//     const_segment parts[] = {{ring_tail, tail_bytes}, {ring_begin, head_bytes}};
+//     read_segments<header_zipped>(parts, header);
+//
+// If the layout fits into the first segment, the usual plan runs on it. If it is split over two segments at byte B, the leaves of the
+// layout are partitioned into the ones before B, the ones behind B and the few that share a byte with the boundary. The first two
+// groups are read with their regular plans straight from their segment, only the leaves at the boundary go through a small stage
+// buffer. The split position is dispatched at runtime into one specialized plan per possible B.
+namespace netser
+{
+
+    // basic_segment
+    // One contiguous part of a packet.
+    template <typename Byte>
+    struct basic_segment
+    {
+        Byte *data;
+        size_t size;
+    };
+
+    using const_segment = basic_segment<const std::byte>;
+    using mutable_segment = basic_segment<std::byte>;
+
+    // segment_split_max_bytes
+    // Largest layout with a specialized plan for every split position. Larger layouts that do not fit into one segment are gathered
+    // into (or scattered from) a stage buffer as a whole.
+    constexpr size_t segment_split_max_bytes = 64;
+
+    namespace detail
+    {
+
+        //
+        // Leaf partitioning
+        //
+
+        enum class segment_part : unsigned char
+        {
+            before,  // all bytes in front of the split
+            behind,  // all bytes behind the split
+            boundary // shares a byte with the split or with another boundary leaf
+        };
+
+        // split_layout
+        // Leaf bit ranges of Layout and their partition for every split position.
+        template <typename Layout>
+        struct split_layout
+        {
+            static constexpr size_t leaf_count = leaf_count_v<Layout>;
+            static constexpr size_t bytes = layout_size_v<Layout> / 8;
+
+            using bit_array = std::array<size_t, leaf_count>;
+            using part_array = std::array<segment_part, leaf_count>;
+
+            static constexpr bit_array leaf_begin = leaf_bits<Layout, leaf_count>().first;
+            static constexpr bit_array leaf_end = leaf_bits<Layout, leaf_count>().second;
+
+            // partition
+            // Leaves touching byte Split and its neighbours on the other side of the boundary are put into the boundary group, which is
+            // then grown by every leaf sharing a byte with it. So each group starts and ends on a byte boundary.
+            static constexpr part_array partition(size_t split)
+            {
+                part_array parts{};
+                size_t first = bytes, last = 0;
+                for (size_t i = 0; i < leaf_count; ++i)
+                {
+                    const size_t first_byte = leaf_begin[i] / 8;
+                    const size_t end_byte = (leaf_end[i] + 7) / 8;
+                    if (end_byte <= split)
+                        parts[i] = segment_part::before;
+                    else if (first_byte >= split)
+                        parts[i] = segment_part::behind;
+                    else
+                    {
+                        parts[i] = segment_part::boundary;
+                        first = first_byte < first ? first_byte : first;
+                        last = end_byte > last ? end_byte : last;
+                    }
+                }
+
+                for (bool grown = first < last; grown;)
+                {
+                    grown = false;
+                    for (size_t i = 0; i < leaf_count; ++i)
+                    {
+                        const size_t first_byte = leaf_begin[i] / 8;
+                        const size_t end_byte = (leaf_end[i] + 7) / 8;
+                        if (parts[i] != segment_part::boundary && leaf_end[i] > leaf_begin[i] && first_byte < last && end_byte > first)
+                        {
+                            parts[i] = segment_part::boundary;
+                            first = first_byte < first ? first_byte : first;
+                            last = end_byte > last ? end_byte : last;
+                            grown = true;
+                        }
+                    }
+                }
+                return parts;
+            }
+
+            // select
+            // Selection of the leaves in Part, see select_leaves_t.
+            static constexpr std::array<bool, leaf_count> select(size_t split, segment_part part)
+            {
+                const part_array parts = partition(split);
+                std::array<bool, leaf_count> result{};
+                for (size_t i = 0; i < leaf_count; ++i)
+                    result[i] = parts[i] == part;
+                return result;
+            }
+
+            // boundary_bytes
+            // Byte range [first, second) of the boundary group, empty if the split falls between two leaves.
+            static constexpr std::pair<size_t, size_t> boundary_bytes(size_t split)
+            {
+                const part_array parts = partition(split);
+                size_t first = bytes, last = 0;
+                for (size_t i = 0; i < leaf_count; ++i)
+                {
+                    if (parts[i] == segment_part::boundary)
+                    {
+                        first = leaf_begin[i] / 8 < first ? leaf_begin[i] / 8 : first;
+                        last = (leaf_end[i] + 7) / 8 > last ? (leaf_end[i] + 7) / 8 : last;
+                    }
+                }
+                return first < last ? std::pair<size_t, size_t>{first, last} : std::pair<size_t, size_t>{split, split};
+            }
+        };
+
+        // shift_leaves
+        // Like select_leaves, but the result starts at bit Base of Layout: the unselected leaves are cut down to their bits behind Base,
+        // so the selected leaves (which must lie behind Base) are placed relative to Base.
+        template <typename Layout, typename Node, auto Selected, size_t Base, size_t FirstLeaf, bool IsLeaf = Node::num_children == 0>
+        struct shift_leaves
+        {
+            static constexpr size_t begin = split_layout<Layout>::leaf_begin[FirstLeaf];
+            static constexpr size_t end = split_layout<Layout>::leaf_end[FirstLeaf];
+            static_assert(!Selected[FirstLeaf] || begin >= Base, "Selected leaves must lie behind the base.");
+
+            using type = std::conditional_t<Selected[FirstLeaf], Node, skip<(end > Base) ? end - std::max(begin, Base) : 0>>;
+        };
+
+        template <typename Layout, typename Node, auto Selected, size_t Base, size_t FirstLeaf>
+        struct shift_leaves<Layout, Node, Selected, Base, FirstLeaf, false>
+        {
+            template <size_t... Index>
+            static auto select(std::index_sequence<Index...>)
+                -> layout<typename shift_leaves<Layout, typename Node::template get_child<Index>, Selected, Base,
+                                                FirstLeaf + child_leaf_offset<Node, Index>()>::type...>;
+
+            using type = decltype(select(std::make_index_sequence<Node::num_children>()));
+        };
+
+        // split_part_t
+        // Leaves of Layout in Part for the split at byte Split, placed relative to byte Base.
+        template <typename Layout, size_t Split, segment_part Part, size_t Base = 0>
+        using split_part_t = typename shift_leaves<Layout, Layout, split_layout<Layout>::select(Split, Part), Base * 8, 0>::type;
+
+        // segment_pointer
+        // aligned_ptr at data (which is SegmentAlignment aligned), valid for its first Bytes bytes.
+        template <size_t SegmentAlignment, size_t Bytes, typename Byte>
+        NETSER_FORCE_INLINE auto segment_pointer(Byte *data)
+        {
+            return aligned_ptr<Byte, SegmentAlignment, 0, bounded<0, int(Bytes) + 1>>(data);
+        }
+
+        //
+        // Split reads and writes
+        //
+
+        template <typename Zipped, size_t SegmentAlignment, size_t Split, typename Dest>
+        NETSER_FORCE_INLINE void read_split(const std::byte *first, const std::byte *second, Dest &dest)
+        {
+            using layout = typename Zipped::layout;
+            using mapping = typename Zipped::mapping;
+            constexpr size_t bytes = split_layout<layout>::bytes;
+            constexpr auto boundary = split_layout<layout>::boundary_bytes(Split);
+
+            read_inline<split_part_t<layout, Split, segment_part::before>, mapping>(segment_pointer<SegmentAlignment, Split>(first), dest);
+            read_inline<split_part_t<layout, Split, segment_part::behind, Split>, mapping>(
+                segment_pointer<SegmentAlignment, bytes - Split>(second), dest);
+
+            if constexpr (boundary.first < boundary.second)
+            {
+                alignas(staging_alignment) std::byte stage[boundary.second - boundary.first];
+                std::memcpy(stage, first + boundary.first, Split - boundary.first);
+                std::memcpy(stage + (Split - boundary.first), second, boundary.second - Split);
+
+                read_inline<split_part_t<layout, Split, segment_part::boundary, boundary.first>, mapping>(
+                    segment_pointer<staging_alignment, boundary.second - boundary.first>(static_cast<const std::byte *>(stage)), dest);
+            }
+        }
+
+        template <typename Zipped, size_t SegmentAlignment, size_t Split, typename Src>
+        NETSER_FORCE_INLINE void write_split(std::byte *first, std::byte *second, const Src &src)
+        {
+            using layout = typename Zipped::layout;
+            using mapping = typename Zipped::mapping;
+            constexpr size_t bytes = split_layout<layout>::bytes;
+            constexpr auto boundary = split_layout<layout>::boundary_bytes(Split);
+
+            write_inline<split_part_t<layout, Split, segment_part::before>, mapping>(segment_pointer<SegmentAlignment, Split>(first), src);
+            write_inline<split_part_t<layout, Split, segment_part::behind, Split>, mapping>(
+                segment_pointer<SegmentAlignment, bytes - Split>(second), src);
+
+            if constexpr (boundary.first < boundary.second)
+            {
+                alignas(staging_alignment) std::byte stage[boundary.second - boundary.first] = {};
+                write_inline<split_part_t<layout, Split, segment_part::boundary, boundary.first>, mapping>(
+                    segment_pointer<staging_alignment, boundary.second - boundary.first>(static_cast<std::byte *>(stage)), src);
+
+                std::memcpy(first + boundary.first, stage, Split - boundary.first);
+                std::memcpy(second, stage + (Split - boundary.first), boundary.second - Split);
+            }
+        }
+
+        // dispatch_split
+        // if-chain over the split positions 1..bytes-1, see dispatch_defect.
+        template <size_t Bytes, size_t Split = 1, typename F>
+        NETSER_FORCE_INLINE void dispatch_split(size_t split, F &&f)
+        {
+            if constexpr (Split + 1 == Bytes)
+            {
+                f(std::integral_constant<size_t, Split>());
+            }
+            else
+            {
+                if (split == Split)
+                {
+                    f(std::integral_constant<size_t, Split>());
+                    return;
+                }
+                dispatch_split<Bytes, Split + 1>(split, std::forward<F>(f));
+            }
+        }
+
+        // next_segment
+        // Index of the first non-empty segment at or behind index.
+        template <typename Byte>
+        size_t next_segment(std::span<const basic_segment<Byte>> segments, size_t index)
+        {
+            while (index < segments.size() && segments[index].size == 0)
+                ++index;
+            return index;
+        }
+
+        template <typename Byte>
+        size_t total_size(std::span<const basic_segment<Byte>> segments)
+        {
+            size_t result = 0;
+            for (const auto &segment : segments)
+                result += segment.size;
+            return result;
+        }
+
+    } // namespace detail
+
+    // read_segments< Zipped, SegmentAlignment >( segments : span<const const_segment>, dest : Dest& )
+    // Reads dest from the bytes of the segments in order. SegmentAlignment is the alignment of every segment's data pointer.
+    // Returns the number of bytes read or span_error::too_short if the segments hold less than the layout.
+    template <concepts::Zipped Zipped, size_t SegmentAlignment = 1, typename Dest>
+    span_result read_segments(std::span<const const_segment> segments, Dest &dest)
+    {
+        using layout = typename Zipped::layout;
+        static_assert(!layout_is_dynamic_v<layout>, "Segmented reads need a layout of static size.");
+        static_assert(layout_size_v<layout> % 8 == 0 && layout_size_v<layout> > 0, "Layout must span whole bytes.");
+        constexpr size_t bytes = layout_size_v<layout> / 8;
+
+        if (detail::total_size(segments) < bytes)
+        {
+            return detail::span_failure(span_error::too_short);
+        }
+
+        const size_t first = detail::next_segment(segments, 0);
+        if (segments[first].size >= bytes)
+        {
+            read_zipped_inline<Zipped>(detail::segment_pointer<SegmentAlignment, bytes>(segments[first].data), dest);
+            return bytes;
+        }
+
+        const size_t second = detail::next_segment(segments, first + 1);
+        if constexpr (bytes > 1 && bytes <= segment_split_max_bytes)
+        {
+            if (segments[first].size + segments[second].size >= bytes)
+            {
+                detail::dispatch_split<bytes>(segments[first].size, [&](auto split) {
+                    detail::read_split<Zipped, SegmentAlignment, decltype(split)::value>(segments[first].data, segments[second].data,
+                                                                                          dest);
+                });
+                return bytes;
+            }
+        }
+
+        // Spread over more than two segments: gather into a stage
+        alignas(detail::staging_alignment) std::byte stage[bytes];
+        size_t gathered = 0;
+        for (size_t index = first; gathered < bytes; index = detail::next_segment(segments, index + 1))
+        {
+            const size_t count = std::min(segments[index].size, bytes - gathered);
+            std::memcpy(stage + gathered, segments[index].data, count);
+            gathered += count;
+        }
+
+        read_zipped_inline<Zipped>(detail::segment_pointer<detail::staging_alignment, bytes>(static_cast<const std::byte *>(stage)), dest);
+        return bytes;
+    }
+
+    // write_segments< Zipped, SegmentAlignment >( segments : span<const mutable_segment>, src : const Src& )
+    // Writes src to the bytes of the segments in order, see read_segments.
+    template <concepts::Zipped Zipped, size_t SegmentAlignment = 1, typename Src>
+    span_result write_segments(std::span<const mutable_segment> segments, const Src &src)
+    {
+        using layout = typename Zipped::layout;
+        static_assert(!layout_is_dynamic_v<layout>, "Segmented writes need a layout of static size.");
+        static_assert(layout_size_v<layout> % 8 == 0 && layout_size_v<layout> > 0, "Layout must span whole bytes.");
+        constexpr size_t bytes = layout_size_v<layout> / 8;
+
+        if (detail::total_size(segments) < bytes)
+        {
+            return detail::span_failure(span_error::too_short);
+        }
+
+        const size_t first = detail::next_segment(segments, 0);
+        if (segments[first].size >= bytes)
+        {
+            write_zipped_inline<Zipped>(detail::segment_pointer<SegmentAlignment, bytes>(segments[first].data), src);
+            return bytes;
+        }
+
+        const size_t second = detail::next_segment(segments, first + 1);
+        if constexpr (bytes > 1 && bytes <= segment_split_max_bytes)
+        {
+            if (segments[first].size + segments[second].size >= bytes)
+            {
+                detail::dispatch_split<bytes>(segments[first].size, [&](auto split) {
+                    detail::write_split<Zipped, SegmentAlignment, decltype(split)::value>(segments[first].data, segments[second].data,
+                                                                                           src);
+                });
+                return bytes;
+            }
+        }
+
+        // Spread over more than two segments: scatter from a stage
+        alignas(detail::staging_alignment) std::byte stage[bytes] = {};
+        write_zipped_inline<Zipped>(detail::segment_pointer<detail::staging_alignment, bytes>(static_cast<std::byte *>(stage)), src);
+
+        size_t scattered = 0;
+        for (size_t index = first; scattered < bytes; index = detail::next_segment(segments, index + 1))
+        {
+            const size_t count = std::min(segments[index].size, bytes - scattered);
+            std::memcpy(segments[index].data, stage + scattered, count);
+            scattered += count;
+        }
+        return bytes;
+    }
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,166 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_SWAP_KERNELS_HPP__
+#define NETSER_SWAP_KERNELS_HPP__
+
+#include <netser/aligned_ptr.hpp>
+#include <netser/platform.hpp>
+#include <meta/tlist.hpp>
+#include <type_traits>
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#elif defined(__SSSE3__)
+#include <tmmintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#endif
+
+// Byte swapping copies of whole integer arrays.
+// The vector kernels are selected by the instruction sets the translation unit is compiled for (AVX2 > SSSE3 > SSE2), the scalar kernel
+// is used everywhere else and for the elements before and after the vector blocks.
+namespace netser
+{
+    namespace detail
+    {
+
+        template <size_t Size>
+        struct access_size_matches
+        {
+            template <typename Access>
+            struct type
+            {
+                static constexpr bool value = Access::size == Size;
+            };
+        };
+
+        template <size_t Size, typename Accesses = meta::type_list::copy_if<platform_memory_accesses, access_size_matches<Size>::template type>,
+                  bool Empty = meta::type_list::is_empty<Accesses>>
+        struct native_byte_order
+        {
+            static constexpr bool known = false;
+        };
+
+        template <size_t Size, typename Accesses>
+        struct native_byte_order<Size, Accesses, false>
+        {
+            static constexpr bool known = true;
+            static constexpr byte_order value = meta::type_list::front<Accesses>::endianess;
+        };
+
+        // swap_copy_scalar
+        // Copies Count elements of type T from src to dest, reversing the bytes of each element.
+        template <typename T, size_t Count>
+        NETSER_FORCE_INLINE void swap_copy_scalar(unsigned char *dest, const unsigned char *src)
+        {
+            for (size_t i = 0; i < Count; ++i)
+            {
+                T val;
+                copy_bytes<sizeof(T)>(&val, src + i * sizeof(T));
+                val = conditional_swap<true>(val);
+                copy_bytes<sizeof(T)>(dest + i * sizeof(T), &val);
+            }
+        }
+
+#if defined(__SSSE3__) || defined(__AVX2__)
+        template <size_t ElementSize>
+        NETSER_FORCE_INLINE __m128i swap_mask128()
+        {
+            if constexpr (ElementSize == 2)
+                return _mm_setr_epi8(1, 0, 3, 2, 5, 4, 7, 6, 9, 8, 11, 10, 13, 12, 15, 14);
+            else if constexpr (ElementSize == 4)
+                return _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+            else
+                return _mm_setr_epi8(7, 6, 5, 4, 3, 2, 1, 0, 15, 14, 13, 12, 11, 10, 9, 8);
+        }
+
+        template <size_t ElementSize>
+        NETSER_FORCE_INLINE __m128i swap128(__m128i val)
+        {
+            return _mm_shuffle_epi8(val, swap_mask128<ElementSize>());
+        }
+#define NETSER_SWAP_KERNEL_128
+#elif defined(__SSE2__) || defined(_M_X64)
+        template <size_t ElementSize>
+        NETSER_FORCE_INLINE __m128i swap128(__m128i val)
+        {
+            // Reorder the 16 bit words of each element first, then swap the bytes within the words.
+            if constexpr (ElementSize == 4)
+            {
+                val = _mm_shufflehi_epi16(_mm_shufflelo_epi16(val, _MM_SHUFFLE(2, 3, 0, 1)), _MM_SHUFFLE(2, 3, 0, 1));
+            }
+            else if constexpr (ElementSize == 8)
+            {
+                val = _mm_shufflehi_epi16(_mm_shufflelo_epi16(val, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+            }
+            return _mm_or_si128(_mm_slli_epi16(val, 8), _mm_srli_epi16(val, 8));
+        }
+#define NETSER_SWAP_KERNEL_128
+#endif
+
+        // swap_copy_plan
+        // Splits Count elements into a scalar head, a run of vector blocks and a scalar tail. If the residue class of the net side
+        // pointer (NetAlignment, NetDefect) is known to reach 16 byte alignment at an element border, the head covers the elements up
+        // to that border and the vector blocks use aligned accesses on the net side. Otherwise there is no head and all vector accesses
+        // are unaligned.
+        template <size_t ElementSize, size_t Count, size_t NetAlignment, size_t NetDefect, size_t VectorSize = 16>
+        struct swap_copy_plan
+        {
+            static constexpr bool net_aligned = NetAlignment % VectorSize == 0 && NetDefect % ElementSize == 0;
+            static constexpr size_t head_bytes = net_aligned ? (VectorSize - NetDefect % VectorSize) % VectorSize : 0;
+            static constexpr size_t head = min<size_t>(head_bytes / ElementSize, Count);
+            static constexpr size_t per_vector = VectorSize / ElementSize;
+            static constexpr size_t blocks = (Count - head) / per_vector;
+            static constexpr size_t tail = Count - head - blocks * per_vector;
+        };
+
+        // swap_copy
+        // Copies Count elements of type T between the net buffer and a contiguous host array, reversing the bytes of each element.
+        // NetIsSource selects the direction (read: net -> host, write: host -> net).
+        template <typename T, size_t Count, size_t NetAlignment, size_t NetDefect, bool NetIsSource>
+        NETSER_FORCE_INLINE void swap_copy(unsigned char *dest, const unsigned char *src)
+        {
+#ifdef NETSER_SWAP_KERNEL_128
+            using plan = swap_copy_plan<sizeof(T), Count, NetAlignment, NetDefect>;
+            constexpr bool aligned_load = plan::net_aligned && NetIsSource;
+            constexpr bool aligned_store = plan::net_aligned && !NetIsSource;
+
+            swap_copy_scalar<T, plan::head>(dest, src);
+            dest += plan::head * sizeof(T);
+            src += plan::head * sizeof(T);
+
+            size_t block = 0;
+#ifdef __AVX2__
+            // Two vectors per iteration, the alignment of the second half only follows from the first one for 16 byte vectors.
+            const __m256i mask256 = _mm256_broadcastsi128_si256(swap_mask128<sizeof(T)>());
+            for (; block + 2 <= plan::blocks; block += 2)
+            {
+                __m256i val = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + block * 16));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dest + block * 16), _mm256_shuffle_epi8(val, mask256));
+            }
+#endif
+            for (; block < plan::blocks; ++block)
+            {
+                __m128i val = aligned_load ? _mm_load_si128(reinterpret_cast<const __m128i *>(src + block * 16))
+                                           : _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + block * 16));
+                val = swap128<sizeof(T)>(val);
+                if constexpr (aligned_store)
+                    _mm_store_si128(reinterpret_cast<__m128i *>(dest + block * 16), val);
+                else
+                    _mm_storeu_si128(reinterpret_cast<__m128i *>(dest + block * 16), val);
+            }
+
+            swap_copy_scalar<T, plan::tail>(dest + plan::blocks * 16, src + plan::blocks * 16);
+#else
+            swap_copy_scalar<T, Count>(dest, src);
+#endif
+        }
+
+    } // namespace detail
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,219 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_TLV_HPP__
+#define NETSER_TLV_HPP__
+
+#include <netser/aligned_ptr.hpp>
+#include <netser/checked.hpp>
+#include <netser/integer.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/zipped.hpp>
+#include <cstddef>
+#include <iterator>
+#include <utility>
+
+// Type-length-value sequences.
+// Walks the records of a buffer in place, every payload is handed out as an aligned_ptr:
+//
+//     for (auto record : make_tlv_range<ptp_tlv>(make_aligned_ptr<8>(tlvs), size)) {
+//         if (record.type == 0x8) { path_trace trace; if (record >> trace) { ... } }
+//     }
+//
+// Records follow each other at runtime offsets, so the record pointers only keep the residue class modulo the largest power of two
+// dividing LengthGranularity (PTP pads all TLVs to an even length, which keeps 2 byte alignment).
+namespace netser
+{
+
+    // tlv_format
+    // TypeField and LengthField are integer fields, the length counts payload bytes and is a multiple of LengthGranularity.
+    template <typename TypeField, typename LengthField, size_t LengthGranularity = 1>
+    struct tlv_format
+    {
+        static_assert((TypeField::size + LengthField::size) % 8 == 0, "TLV header must span whole bytes.");
+
+        static constexpr size_t header_bytes = (TypeField::size + LengthField::size) / 8;
+        static constexpr size_t granularity = LengthGranularity;
+
+        static_assert(header_bytes % granularity == 0, "TLV header must be a multiple of the length granularity.");
+
+        using layout = netser::layout<TypeField, LengthField>;
+    };
+
+    using ptp_tlv = tlv_format<net_uint16, net_uint16, 2>;
+
+    // tlv_record
+    // One record. payload points at the first value byte.
+    template <typename PayloadPtr>
+    struct tlv_record
+    {
+        size_t type;
+        size_t length;
+        PayloadPtr payload;
+
+        // Decodes the payload with the default zipped layout of dest if the record is long enough for it, see read_checked. The plan
+        // only accesses the bytes of the layout.
+        template <typename Dest>
+        friend span_result operator>>(const tlv_record &record, Dest &&dest)
+        {
+            using zipped = default_zipped_t<Dest &&>;
+            static_assert(!layout_is_dynamic_v<typename zipped::layout>, "Payloads are decoded with layouts of static size.");
+            static_assert(layout_size_v<typename zipped::layout> % 8 == 0, "Layout must span whole bytes.");
+            constexpr size_t bytes = layout_size_v<typename zipped::layout> / 8;
+
+            if (record.length < bytes)
+            {
+                return detail::span_failure(span_error::too_short);
+            }
+
+            using bounded_payload = aligned_ptr<typename PayloadPtr::value_type, PayloadPtr::get_max_alignment(),
+                                                PayloadPtr::get_pointer_defect(), bounded<0, int(bytes) + 1>>;
+#ifdef NETSER_DEREFERENCE_LOGGING
+            read_zipped_inline<zipped>(bounded_payload(record.payload.get(), record.payload.logger_), dest);
+#else
+            read_zipped_inline<zipped>(bounded_payload(record.payload.get()), dest);
+#endif
+            return bytes;
+        }
+    };
+
+    // tlv_iterator
+    // Forward iterator over the records of a buffer, compares equal to std::default_sentinel at the end of the buffer or at the first
+    // record whose length is malformed or exceeds the buffer. A default constructed iterator is at the end.
+    template <typename Format, typename RecordPtr>
+    class tlv_iterator
+    {
+      public:
+        using payload_pointer = typename RecordPtr::template static_offset_t<int(Format::header_bytes)>;
+        using value_type = tlv_record<payload_pointer>;
+        using difference_type = std::ptrdiff_t;
+        using iterator_concept = std::forward_iterator_tag;
+
+        tlv_iterator() = default;
+
+        tlv_iterator(RecordPtr record, const unsigned char *end)
+            : ptr_(record.get()),
+#ifdef NETSER_DEREFERENCE_LOGGING
+              logger_(record.logger_),
+#endif
+              end_(end)
+        {
+            decode();
+        }
+
+        value_type operator*() const
+        {
+            return {type_, length_, record().template static_offset<int(Format::header_bytes)>()};
+        }
+
+        tlv_iterator &operator++()
+        {
+            ptr_ = record().template stride<Format::granularity>((Format::header_bytes + length_) / Format::granularity).get();
+            decode();
+            return *this;
+        }
+
+        tlv_iterator operator++(int)
+        {
+            tlv_iterator result = *this;
+            ++*this;
+            return result;
+        }
+
+        friend bool operator==(const tlv_iterator &it, std::default_sentinel_t)
+        {
+            return it.done_;
+        }
+
+        friend bool operator==(const tlv_iterator &a, const tlv_iterator &b)
+        {
+            return a.done_ == b.done_ && (a.done_ || a.ptr_ == b.ptr_);
+        }
+
+      private:
+        struct header
+        {
+            size_t type;
+            size_t length;
+        };
+
+        using header_mapping = mapping_list<mem<&header::type>, mem<&header::length>>;
+
+        // aligned_ptr is not assignable, so the iterator keeps the plain pointer and rebuilds the record pointer from it.
+        RecordPtr record() const
+        {
+#ifdef NETSER_DEREFERENCE_LOGGING
+            return RecordPtr(ptr_, logger_);
+#else
+            return RecordPtr(ptr_);
+#endif
+        }
+
+        void decode()
+        {
+            const auto *begin = reinterpret_cast<const unsigned char *>(ptr_);
+            if (size_t(end_ - begin) < Format::header_bytes)
+            {
+                done_ = true;
+                return;
+            }
+
+            header hdr{};
+            read_inline<typename Format::layout, header_mapping>(record(), hdr);
+
+            type_ = hdr.type;
+            length_ = hdr.length;
+            done_ = length_ % Format::granularity != 0 || length_ > size_t(end_ - begin) - Format::header_bytes;
+        }
+
+        typename RecordPtr::value_type *ptr_ = nullptr;
+#ifdef NETSER_DEREFERENCE_LOGGING
+        dereference_logger *logger_ = nullptr;
+#endif
+        const unsigned char *end_ = nullptr;
+        size_t type_ = 0;
+        size_t length_ = 0;
+        bool done_ = true;
+    };
+
+    // tlv_range
+    template <typename Format, typename RecordPtr>
+    class tlv_range
+    {
+      public:
+        tlv_range(RecordPtr first, const unsigned char *end) : first_(first), end_(end)
+        {
+        }
+
+        tlv_iterator<Format, RecordPtr> begin() const
+        {
+            return {first_, end_};
+        }
+
+        std::default_sentinel_t end() const
+        {
+            return {};
+        }
+
+      private:
+        RecordPtr first_;
+        const unsigned char *end_;
+    };
+
+    // make_tlv_range< Format >( first : aligned_ptr<>, bytes )
+    // Records in the bytes bytes starting at first.
+    template <typename Format, typename AlignedPtr>
+    auto make_tlv_range(AlignedPtr first, size_t bytes)
+    {
+        // The record pointer type is a fixed point of stride, so all records share one type.
+        using record_pointer = decltype(first.template stride<Format::granularity>(0));
+        return tlv_range<Format, record_pointer>(first.template stride<Format::granularity>(0),
+                                                 reinterpret_cast<const unsigned char *>(first.get()) + bytes);
+    }
+
+} // namespace netser
+
+#endif
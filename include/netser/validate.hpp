@@ -0,0 +1,186 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_VALIDATE_HPP__
+#define NETSER_VALIDATE_HPP__
+
+#include <netser/field.hpp>
+#include <netser/mapping.hpp>
+#include <netser/read.hpp>
+#include <netser/zipped.hpp>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+// Validating reads.
+// Constraints are attached to the mapping side, so the layout and with it the read plan stay the same:
+//
+//     using announce_zipped = zipped<..., reserved<8>,
+//                                    net_uint8, constrained<mem<&Announce::time_source>, enum_values<TimeSource::atomic, TimeSource::gps>>,
+//                                    net_uint8, constrained<mem<&Announce::steps_removed>, in_range<0, 255>>>;
+//
+//     validation_errors errors = read_validated<announce_zipped>(make_aligned_ptr<8>(packet), announce);
+//
+// Every integer field is checked right after it has been extracted from its loaded word. The checks are compares combined into the
+// error mask with bitwise operations, there are no branches. Fields mapped to a constant (reserved<> maps to constant<size_t, 0>) must
+// hold that constant. Fields read by bulk copies (byte arrays) are not checked. A dynamic_array count above its bound is reported and no
+// elements are read.
+namespace netser
+{
+
+    // validation_errors
+    // Mask of validation_error bits.
+    using validation_errors = unsigned;
+
+    enum validation_error : validation_errors
+    {
+        reserved_bits_set = 1u << 0,  // a reserved (or constant) field does not hold its value
+        invalid_enum_value = 1u << 1, // an enum_values field holds an undeclared value
+        value_out_of_range = 1u << 2, // an in_range field is out of range
+        count_out_of_range = 1u << 3  // a dynamic_array count exceeds its MaxCount
+    };
+
+    // enum_values
+    // Constraint: the field holds one of Values.
+    template <auto... Values>
+    struct enum_values
+    {
+        static constexpr validation_errors error = invalid_enum_value;
+
+        template <typename T>
+        static constexpr bool valid(T value)
+        {
+            return (false | ... | (value == static_cast<T>(Values)));
+        }
+    };
+
+    // in_range
+    // Constraint: Min <= field <= Max.
+    template <auto Min, auto Max>
+    struct in_range
+    {
+        static constexpr validation_errors error = value_out_of_range;
+
+        // Bounds at the limits of T are not compared, the compare would always hold (-Wtype-limits).
+        template <typename T>
+        static constexpr bool valid(T value)
+        {
+            constexpr bool check_min = std::cmp_greater(Min, std::numeric_limits<T>::min());
+            constexpr bool check_max = std::cmp_less(Max, std::numeric_limits<T>::max());
+
+            if constexpr (check_min && check_max)
+            {
+                return !(value < static_cast<T>(Min)) & !(static_cast<T>(Max) < value);
+            }
+            else if constexpr (check_min)
+            {
+                return !(value < static_cast<T>(Min));
+            }
+            else if constexpr (check_max)
+            {
+                return !(static_cast<T>(Max) < value);
+            }
+            else
+            {
+                return true;
+            }
+        }
+    };
+
+    // constrained
+    // Mapping that behaves like Mapping and carries Constraint for read_validated.
+    template <typename Mapping, typename Constraint>
+    struct constrained : public Mapping
+    {
+        using constraint = Constraint;
+    };
+
+    namespace detail
+    {
+
+        template <typename Mapping, typename Constraint, auto MemberPtr>
+        constexpr bool same_member_v<constrained<Mapping, Constraint>, MemberPtr> = same_member_v<Mapping, MemberPtr>;
+
+        // field_errors
+        // Error bits of value read into the mapping leaf Mapping.
+        template <typename Mapping, typename Value>
+        NETSER_FORCE_INLINE constexpr validation_errors field_errors(Mapping *, Value)
+        {
+            return 0;
+        }
+
+        template <typename Mapping, typename Constraint, typename Value>
+        NETSER_FORCE_INLINE constexpr validation_errors field_errors(constrained<Mapping, Constraint> *, Value value)
+        {
+            return validation_errors(!Constraint::valid(value)) * Constraint::error;
+        }
+
+        template <typename T, T Constant, typename Value>
+        NETSER_FORCE_INLINE constexpr validation_errors field_errors(constant<T, Constant> *, Value value)
+        {
+            return validation_errors(value != static_cast<Value>(Constant)) * reserved_bits_set;
+        }
+
+        // validation_context
+        // Root argument of a validating read, collects the errors of all fields.
+        template <typename Dest>
+        struct validation_context
+        {
+            Dest &dest;
+            validation_errors errors = 0;
+
+            template <typename MappingIterator, typename Value>
+            NETSER_FORCE_INLINE void validate_field_value(const MappingIterator &, Value value)
+            {
+                using mapping = meta::dereference_t<typename MappingIterator::range>;
+                errors |= field_errors(static_cast<mapping *>(nullptr), value);
+            }
+
+            NETSER_FORCE_INLINE void validate_dynamic_count(bool valid)
+            {
+                errors |= validation_errors(!valid) * count_out_of_range;
+            }
+
+            // host
+            // The object holding the count members of dynamic arrays.
+            Dest &host() const
+            {
+                return dest;
+            }
+        };
+
+        // validating_root
+        // Mapping with the children of Mapping that unwraps the validation_context before applying Mapping.
+        template <typename Mapping>
+        struct validating_root
+        {
+            static constexpr size_t num_children = Mapping::num_children;
+
+            template <size_t Pos>
+            using get_child = typename Mapping::template get_child<Pos>;
+
+            template <typename Dest>
+            static decltype(auto) apply(validation_context<Dest> &context)
+            {
+                return Mapping::apply(context.dest);
+            }
+        };
+
+    } // namespace detail
+
+    // read_validated< Zipped >( source : aligned_ptr<>, dest : Dest& )
+    // Reads dest like read_zipped and returns the mask of validation_errors of its fields (0 if all fields are valid). dest is filled in
+    // either way.
+    template <concepts::Zipped Zipped, typename AlignedPtr, typename Dest>
+    validation_errors read_validated(AlignedPtr ptr, Dest &dest)
+    {
+        detail::validation_context<Dest> context{dest};
+        read_inline<typename Zipped::layout, detail::validating_root<typename Zipped::mapping>>(ptr, context);
+        return context.errors;
+    }
+
+} // namespace netser
+
+#endif
@@ -0,0 +1,217 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_VARIANT_LAYOUT_HPP__
+#define NETSER_VARIANT_LAYOUT_HPP__
+
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/zipped.hpp>
+#include <array>
+#include <utility>
+#include <variant>
+
+// Messages that consist of a common header and one of several bodies, selected by a header field:
+//
+//     using ptp_message = variant_layout<discriminator<header_zipped, &Header::message_type>,
+//                                        variant_case<0x0, Sync>, variant_case<0xb, Announce>>;
+//
+//     Header header;
+//     ptp_message::variant_type body;
+//     if (!ptp_message::read(make_aligned_ptr<8>(packet), header, body)) { /* unknown message type */ }
+//
+// The header is read with its static plan, then a single indirect call through a table indexed by the discriminator value decodes the
+// body. The body starts at the static offset behind the header, so its plan keeps the full residue class of the packet pointer.
+namespace netser
+{
+
+    // discriminator
+    // Header zipped layout and the member of the header that selects the body.
+    template <concepts::Zipped HeaderZipped, auto Member>
+    requires(concepts::MemberPtr<Member>)
+    struct discriminator
+    {
+        using zipped = HeaderZipped;
+        using header_type = typename member_object_pointer_traits<Member>::container_type;
+
+        static_assert(layout_size_v<typename HeaderZipped::layout> % 8 == 0, "Header must span whole bytes.");
+        static constexpr size_t header_bytes = layout_size_v<typename HeaderZipped::layout> / 8;
+
+        static constexpr long long value(const header_type &header)
+        {
+            return static_cast<long long>(header.*Member);
+        }
+    };
+
+    // variant_case
+    // Body Body with zipped layout Zipped, selected by the discriminator value Value.
+    template <auto Value, typename Body, concepts::Zipped Zipped = default_zipped_t<Body &>>
+    struct variant_case
+    {
+        static constexpr long long value = static_cast<long long>(Value);
+        using body = Body;
+        using zipped = Zipped;
+    };
+
+    namespace detail
+    {
+
+        template <typename Case, size_t Index, typename BodyPtr, typename Variant>
+        void read_variant_case(BodyPtr ptr, Variant &dest)
+        {
+            read_zipped_inline<typename Case::zipped>(ptr, dest.template emplace<Index>());
+        }
+
+        template <typename Case, typename BodyPtr, typename Header, typename Handler>
+        void handle_variant_case(BodyPtr ptr, const Header &header, Handler &handler)
+        {
+            typename Case::body body{};
+            read_zipped_inline<typename Case::zipped>(ptr, body);
+            handler(header, body);
+        }
+
+        // variant_dispatch_max_table
+        // Largest range of discriminator values that is dispatched through a dense table, sparser cases are compared one by one.
+        constexpr long long variant_dispatch_max_table = 256;
+
+        template <size_t N>
+        constexpr long long min_value(const std::array<long long, N> &values)
+        {
+            long long result = values[0];
+            for (long long value : values)
+                result = value < result ? value : result;
+            return result;
+        }
+
+        template <size_t N>
+        constexpr long long max_value(const std::array<long long, N> &values)
+        {
+            long long result = values[0];
+            for (long long value : values)
+                result = value > result ? value : result;
+            return result;
+        }
+
+        template <size_t N>
+        constexpr bool unique_values(const std::array<long long, N> &values)
+        {
+            for (size_t i = 0; i < N; ++i)
+                for (size_t j = i + 1; j < N; ++j)
+                    if (values[i] == values[j])
+                        return false;
+            return true;
+        }
+
+    } // namespace detail
+
+    // variant_layout
+    template <typename Discriminator, typename... Cases>
+    struct variant_layout
+    {
+        static_assert(sizeof...(Cases) > 0, "No cases.");
+
+        using header_type = typename Discriminator::header_type;
+        using variant_type = std::variant<typename Cases::body...>;
+
+      private:
+        static constexpr std::array<long long, sizeof...(Cases)> values = {Cases::value...};
+
+        static constexpr long long min_value = detail::min_value(values);
+        static constexpr long long max_value = detail::max_value(values);
+
+        static_assert(detail::unique_values(values), "Discriminator values must be unique.");
+
+        static constexpr bool dense = max_value - min_value < detail::variant_dispatch_max_table;
+
+        // make_table
+        // Dense: the entry of every case at its value minus min_value, holes stay nullptr. Sparse: the entries in case order.
+        template <typename Entry>
+        static constexpr auto make_table(const std::array<Entry, sizeof...(Cases)> &entries)
+        {
+            if constexpr (dense)
+            {
+                std::array<Entry, size_t(max_value - min_value + 1)> table{};
+                for (size_t i = 0; i < entries.size(); ++i)
+                    table[size_t(values[i] - min_value)] = entries[i];
+                return table;
+            }
+            else
+            {
+                return entries;
+            }
+        }
+
+        template <typename Table, typename... Args>
+        static NETSER_FORCE_INLINE bool dispatch_entry(long long key, const Table &table, Args &&...args)
+        {
+            if constexpr (dense)
+            {
+                if (key < min_value || key > max_value)
+                    return false;
+
+                const auto entry = table[size_t(key - min_value)];
+                if (entry == nullptr)
+                    return false;
+
+                entry(std::forward<Args>(args)...);
+                return true;
+            }
+            else
+            {
+                for (size_t i = 0; i < table.size(); ++i)
+                {
+                    if (values[i] == key)
+                    {
+                        table[i](std::forward<Args>(args)...);
+                        return true;
+                    }
+                }
+                return false;
+            }
+        }
+
+        template <typename AlignedPtr>
+        using body_pointer = typename AlignedPtr::template static_offset_t<int(Discriminator::header_bytes)>;
+
+        template <typename AlignedPtr, size_t... Index>
+        static constexpr auto make_read_table(std::index_sequence<Index...>)
+        {
+            using entry = void (*)(body_pointer<AlignedPtr>, variant_type &);
+            return make_table<entry>({&detail::read_variant_case<Cases, Index, body_pointer<AlignedPtr>, variant_type>...});
+        }
+
+      public:
+        // read( source : aligned_ptr<>, header : Header&, body : variant_type& )
+        // Reads the header and the body selected by it. Returns false if no case matches the discriminator, body is left untouched then.
+        template <typename AlignedPtr>
+        static bool read(AlignedPtr src, header_type &header, variant_type &body)
+        {
+            static constexpr auto table = make_read_table<AlignedPtr>(std::index_sequence_for<Cases...>());
+
+            read_zipped_inline<typename Discriminator::zipped>(src, header);
+            return dispatch_entry(Discriminator::value(header), table,
+                                  src.template static_offset<int(Discriminator::header_bytes)>(), body);
+        }
+
+        // dispatch( source : aligned_ptr<>, header : Header&, handler )
+        // Reads the header and the body selected by it into a local object, then calls handler(header, body). Returns false if no case
+        // matches the discriminator, the handler is not called then.
+        template <typename AlignedPtr, typename Handler>
+        static bool dispatch(AlignedPtr src, header_type &header, Handler &&handler)
+        {
+            using handler_type = std::remove_reference_t<Handler>;
+            using entry = void (*)(body_pointer<AlignedPtr>, const header_type &, handler_type &);
+            static constexpr auto table
+                = make_table<entry>({&detail::handle_variant_case<Cases, body_pointer<AlignedPtr>, header_type, handler_type>...});
+
+            read_zipped_inline<typename Discriminator::zipped>(src, header);
+            return dispatch_entry(Discriminator::value(header), table,
+                                  src.template static_offset<int(Discriminator::header_bytes)>(), std::as_const(header), handler);
+        }
+    };
+
+} // namespace netser
+
+#endif
@@ -7,6 +7,7 @@
 #define NETSER_WRITE_HPP__
 
 #include <netser/platform.hpp>
+#include <netser/zip_iterator.hpp>
 
 namespace netser
 {
@@ -27,7 +28,15 @@ namespace netser
 #ifdef NETSER_DEBUG_CONSOLE
                 std::cout << "Span written.\n";
 #endif
-                return write_zip_iterator_struct<decltype(result)>::write(result);
+                if constexpr (is_zip_iterator_v<decltype(result)>)
+                {
+                    return write_zip_iterator_struct<decltype(result)>::write(result);
+                }
+                else
+                {
+                    // The field has written the rest of the layout itself and returned the pointer behind it (see optional_field).
+                    return result;
+                }
             }
         };
 
@@ -36,7 +45,9 @@ namespace netser
         {
             static NETSER_FORCE_INLINE auto write(ZipIterator it)
             {
-                return it.layout().get().template static_offset<ZipIterator::layout_iterator::get_offset()>();
+                static_assert(ZipIterator::layout_iterator::get_offset() % 8 == 0, "Must!");
+                // return a pointer one behind the last field (for continuation)
+                return it.layout().get().template static_offset<ZipIterator::layout_iterator::get_offset() / 8>();
             }
         };
 
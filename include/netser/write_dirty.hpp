@@ -0,0 +1,287 @@
+//          Copyright Michael Steinberg 2016
+// Distributed under the Boost Software License, Version 1.0.
+//    (See accompanying file LICENSE_1_0.txt or copy at
+//          http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef NETSER_WRITE_DIRTY_HPP__
+#define NETSER_WRITE_DIRTY_HPP__
+
+#include <netser/field.hpp>
+#include <netser/layout.hpp>
+#include <netser/mapping.hpp>
+#include <netser/projection.hpp>
+#include <netser/reserved.hpp>
+#include <netser/write.hpp>
+#include <netser/zipped.hpp>
+#include <array>
+#include <bitset>
+
+// Incremental writes.
+// A packet that has been written before is brought up to date by re-encoding only the fields of members that changed:
+//
+//     auto mask = make_dirty_mask<state_zipped, &State::position, &State::flags>();
+//     write_dirty<state_zipped>(make_aligned_ptr<8>(buffer), state, mask);
+//
+// The mask has one bit per leaf of the layout. A run of integer fields whose bits are all dirty is written with its usual plan. Other runs
+// replay the stores of that plan: stores holding only dirty bits are written as usual, stores that mix clean and dirty bits merge the
+// dirty ones under a mask, so the clean bits that share their word are kept, and clean stores are skipped.
+namespace netser
+{
+
+    namespace detail
+    {
+
+        template <typename LayoutMetaIterator, size_t N>
+        constexpr void collect_integer_flags(std::array<bool, N> &integer, size_t index)
+        {
+            if constexpr (!meta::concepts::EmptyRange<LayoutMetaIterator>)
+            {
+                integer[index] = is_integer_v<typename meta::dereference_t<LayoutMetaIterator>::field>;
+                collect_integer_flags<meta::advance_t<LayoutMetaIterator>>(integer, index + 1);
+            }
+        }
+
+        template <typename Layout, size_t LeafCount>
+        constexpr std::array<bool, LeafCount> integer_leaf_flags()
+        {
+            std::array<bool, LeafCount> integer{};
+            collect_integer_flags<layout_enumerator_t<Layout>>(integer, 0);
+            return integer;
+        }
+
+        template <typename Iterator, size_t Count>
+        struct advance_n
+        {
+            using type = typename advance_n<meta::advance_t<Iterator>, Count - 1>::type;
+        };
+
+        template <typename Iterator>
+        struct advance_n<Iterator, 0>
+        {
+            using type = Iterator;
+        };
+
+        template <size_t Count, typename MappingIterator>
+        NETSER_FORCE_INLINE auto advance_mapping(MappingIterator it)
+        {
+            if constexpr (Count == 0)
+                return it;
+            else
+                return advance_mapping<Count - 1>(++it);
+        }
+
+        // dirty_plan
+        // Leaves of Layout and the runs of integers they form.
+        template <typename Layout>
+        struct dirty_plan
+        {
+            static_assert(!layout_is_dynamic_v<Layout>, "Incremental writes need a layout of static size.");
+
+            static constexpr size_t leaf_count = leaf_count_v<Layout>;
+
+            static constexpr std::array<size_t, leaf_count> leaf_begin = leaf_bits<Layout, leaf_count>().first;
+            static constexpr std::array<size_t, leaf_count> leaf_end = leaf_bits<Layout, leaf_count>().second;
+            static constexpr std::array<bool, leaf_count> integer = integer_leaf_flags<Layout, leaf_count>();
+
+            template <size_t Leaf>
+            using placed_leaf = meta::dereference_t<typename advance_n<layout_enumerator_t<Layout>, Leaf>::type>;
+
+            // run_end
+            // One behind the last leaf of the run of integers that starts at first, other leaves form a run of their own.
+            static constexpr size_t run_end(size_t first)
+            {
+                size_t last = first + 1;
+                while (integer[first] && last < leaf_count && integer[last])
+                    ++last;
+                return last;
+            }
+
+            // leaf_at
+            // Leaf holding bit position.
+            static constexpr size_t leaf_at(size_t position)
+            {
+                size_t leaf = 0;
+                while (leaf_end[leaf] <= position)
+                    ++leaf;
+                return leaf;
+            }
+
+            static constexpr std::array<bool, leaf_count> selection(size_t first, size_t last)
+            {
+                std::array<bool, leaf_count> result{};
+                for (size_t i = first; i < last; ++i)
+                    result[i] = true;
+                return rebuilt_selection(result);
+            }
+        };
+
+        // assemble_store
+        // Adds the bits of the integers Leaf.. that fall into the store [StoreBegin, StoreEnd) and the span ending at SpanEnd to bits, in
+        // memory order, and sets them in dirty if their leaf is set in mask.
+        template <typename Zipped, size_t Leaf, size_t StoreBegin, size_t StoreEnd, size_t SpanEnd, typename Word, typename Src,
+                  typename Mask>
+        NETSER_FORCE_INLINE void assemble_store(const Src &src, const Mask &mask, Word &bits, Word &dirty)
+        {
+            using plan = dirty_plan<typename Zipped::layout>;
+
+            if constexpr (Leaf < plan::leaf_count && plan::leaf_begin[Leaf] < min<size_t>(StoreEnd, SpanEnd))
+            {
+                using field = typename plan::template placed_leaf<Leaf>::field;
+                using stage_type = typename field::stage_type;
+
+                constexpr size_t begin = max<size_t>(plan::leaf_begin[Leaf], StoreBegin);
+                constexpr size_t end = min<size_t>(plan::leaf_end[Leaf], StoreEnd);
+                constexpr size_t shift = StoreEnd - end;
+                constexpr auto field_mask = static_cast<Word>(bit_mask<Word>(end - begin) << shift);
+
+                const auto it = advance_mapping<Leaf>(make_mapping_iterator<typename Zipped::mapping>(src));
+                const auto value = swap_field_bytes<field>(static_cast<stage_type>(*it));
+
+                const auto part = static_cast<Word>((value >> (plan::leaf_end[Leaf] - end)) & bit_mask<stage_type>(end - begin));
+                bits |= static_cast<Word>(part << shift);
+                dirty |= mask[Leaf] ? field_mask : Word(0);
+
+                assemble_store<Zipped, Leaf + 1, StoreBegin, StoreEnd, SpanEnd>(src, mask, bits, dirty);
+            }
+        }
+
+        // write_dirty_stores
+        // Replays the stores write_integer_algorithm issues for the integers from bit Position to RunEnd. A store whose bits are all
+        // dirty is written as is, a store that mixes clean and dirty bits merges the dirty ones under a mask (read-modify-write) and a
+        // clean store is skipped.
+        template <typename Zipped, size_t Position, size_t RunEnd, typename AlignedPtr, typename Src, typename Mask>
+        NETSER_FORCE_INLINE void write_dirty_stores(AlignedPtr ptr, const Src &src, const Mask &mask)
+        {
+            using plan = dirty_plan<typename Zipped::layout>;
+
+            if constexpr (Position < RunEnd)
+            {
+                constexpr size_t leaf = plan::leaf_at(Position);
+                using leaf_iterator = typename advance_n<layout_enumerator_t<typename Zipped::layout>, leaf>::type;
+                constexpr size_t field_written = Position - plan::leaf_begin[leaf];
+                constexpr size_t span_size = discover_integer_span_size<leaf_iterator>::value - field_written;
+
+                using access = typename discover_access<leaf_iterator,
+                                                        filtered_accesses_nomove_t<AlignedPtr, int(Position / 8), platform_memory_accesses>,
+                                                        span_size, merge_writes && AlignedPtr::offset_range::has_upper_bound,
+                                                        field_written>::type;
+                using placed_access = placed_memory_access<access, int(Position / 8 * 8), AlignedPtr>;
+                using word_type = typename access::type;
+                constexpr bool swap = access::endianess != byte_order::big_endian;
+
+                constexpr size_t store_begin = Position / 8 * 8;
+                constexpr size_t store_end = store_begin + access::size * 8;
+
+                word_type bits = 0;
+                word_type dirty = 0;
+                assemble_store<Zipped, leaf, store_begin, store_end, Position + span_size>(src, mask, bits, dirty);
+
+                if (dirty == static_cast<word_type>(~word_type(0)))
+                {
+                    placed_access::write(ptr, conditional_swap<swap>(bits));
+                }
+                else if (dirty != 0)
+                {
+                    const auto old = conditional_swap<swap>(placed_access::read(ptr));
+                    placed_access::write(
+                        ptr, conditional_swap<swap>(static_cast<word_type>((old & static_cast<word_type>(~dirty)) | (bits & dirty))));
+                }
+
+                write_dirty_stores<Zipped, min<size_t>(store_end, Position + span_size), RunEnd>(ptr, src, mask);
+            }
+        }
+
+        // write_dirty_runs
+        // Writes the run starting at leaf First and all runs behind it.
+        template <typename Zipped, size_t First, typename AlignedPtr, typename Src, typename Mask>
+        NETSER_FORCE_INLINE void write_dirty_runs(AlignedPtr ptr, const Src &src, const Mask &mask)
+        {
+            using plan = dirty_plan<typename Zipped::layout>;
+
+            if constexpr (First < plan::leaf_count)
+            {
+                constexpr size_t last = plan::run_end(First);
+                constexpr bool whole_bytes = plan::leaf_begin[First] % 8 == 0 && plan::leaf_end[last - 1] % 8 == 0;
+
+                bool all_dirty = true;
+                bool any_dirty = false;
+                for (size_t i = First; i < last; ++i)
+                {
+                    all_dirty = all_dirty && mask[i];
+                    any_dirty = any_dirty || mask[i];
+                }
+
+                if constexpr (whole_bytes)
+                {
+                    if (all_dirty)
+                    {
+                        write_inline<select_leaves_t<typename Zipped::layout, plan::selection(First, last)>, typename Zipped::mapping>(ptr,
+                                                                                                                                        src);
+                    }
+                    else if constexpr (plan::integer[First])
+                    {
+                        if (any_dirty)
+                        {
+                            write_dirty_stores<Zipped, plan::leaf_begin[First], plan::leaf_end[last - 1]>(ptr, src, mask);
+                        }
+                    }
+                }
+                else
+                {
+                    static_assert(plan::integer[First], "Only integer fields may share bytes with other fields.");
+                    if (any_dirty)
+                    {
+                        write_dirty_stores<Zipped, plan::leaf_begin[First], plan::leaf_end[last - 1]>(ptr, src, mask);
+                    }
+                }
+
+                write_dirty_runs<Zipped, last>(ptr, src, mask);
+            }
+        }
+
+    } // namespace detail
+
+    // dirty_mask< Zipped >
+    // One bit per leaf of the layout of Zipped.
+    template <concepts::Zipped Zipped>
+    using dirty_mask = std::bitset<leaf_count_v<typename Zipped::layout>>;
+
+    // make_dirty_mask< Zipped, &Struct::member... >()
+    // Mask with the bits of the leaves mapped onto the given members set.
+    template <concepts::Zipped Zipped, auto... MemberPtrs>
+    requires((concepts::MemberPtr<MemberPtrs> && ...))
+    dirty_mask<Zipped> make_dirty_mask()
+    {
+        using flat = detail::flatten_zipped<layout_enumerator_t<typename Zipped::layout>, mapping_range_t<typename Zipped::mapping>>;
+        using selection = detail::member_selection<MemberPtrs...>;
+        constexpr size_t count = leaf_count_v<typename Zipped::layout>;
+
+        static_assert((selection::template is_mapped<MemberPtrs, typename flat::mappings>(std::make_index_sequence<count>()) && ...),
+                      "A member is not mapped by the zipped layout.");
+
+        constexpr std::array<bool, count> flags = selection::template flags<typename flat::mappings>(std::make_index_sequence<count>());
+
+        dirty_mask<Zipped> mask;
+        for (size_t i = 0; i < count; ++i)
+            mask[i] = flags[i];
+        return mask;
+    }
+
+    // write_dirty< Zipped >( dest : aligned_ptr<>, src : const Src&, mask : dirty_mask<Zipped> )
+    // Updates a buffer holding an earlier write of Zipped with the fields of src whose bits are set in mask.
+    template <concepts::Zipped Zipped, typename AlignedPtr, typename Src>
+    void write_dirty(AlignedPtr ptr, const Src &src, const dirty_mask<Zipped> &mask)
+    {
+        if (mask.all())
+        {
+            write_zipped_inline<Zipped>(ptr, src);
+        }
+        else if (mask.any())
+        {
+            detail::write_dirty_runs<Zipped, 0>(ptr, src, mask);
+        }
+    }
+
+} // namespace netser
+
+#endif
@@ -46,6 +46,17 @@ namespace netser {
             }
         }
 
+        // advance_dynamic
+        // Advances past a dynamic-length field, see layout_iterator::advance_dynamic.
+        template <typename... Args>
+        constexpr auto advance_dynamic(Args... args) const
+        {
+            static_assert(!is_end, "Advancing an end iterator!");
+
+            auto next_layout = layout_.advance_dynamic(args...);
+            return zip_iterator< decltype(next_layout), next_mapping_iterator >( next_layout, ++mapping_ );
+        }
+
         constexpr auto operator*() const {
             return std::make_pair( *layout_, *mapping_ );
         }
@@ -61,6 +72,13 @@ namespace netser {
         }
     };
 
+    // is_zip_iterator_v
+    template< typename T >
+    constexpr bool is_zip_iterator_v = false;
+
+    template< typename LayoutIterator, typename MappingIterator >
+    constexpr bool is_zip_iterator_v< zip_iterator< LayoutIterator, MappingIterator > > = true;
+
     template< typename ZipIterator >
     using zip_field_t = typename meta::dereference_t<typename ZipIterator::layout_iterator>::field;
 
@@ -122,7 +122,7 @@ namespace netser
         using layout = typename Zipped::layout;
         using mapping = typename Zipped::mapping;
 
-        return write_inline<layout, mapping>(dest, std::forward<Arg>(src));
+        write_inline<layout, mapping>(dest, std::forward<Arg>(src));
     }
 
     template <typename Zipped, typename AlignedPtr, typename Arg>
@@ -0,0 +1,118 @@
+// Compares the reinterpret and copy dereference modes of aligned_ptr.
+//
+// The probe functions are kept out of line so their code can be compared in the disassembly.txt generated by the post build step:
+// both modes must produce the same single load/store per probe. dereference_bench() checks that both modes agree on every probe and on a
+// word summing loop. Host builds may define NETSER_DEREFERENCE_BENCH_TIMING to also time the loop in both modes, the bare-metal target
+// has no clock to do so.
+#include <cstdint>
+#include <netser/aligned_ptr.hpp>
+
+#ifdef NETSER_DEREFERENCE_BENCH_TIMING
+#include <chrono>
+#include <iostream>
+#endif
+
+namespace dereference_bench_detail {
+
+    using netser::dereference_mode;
+    using netser::make_aligned_ptr;
+
+    alignas(8) unsigned char buffer[4096];
+
+    template <typename T, dereference_mode Mode>
+    __attribute__((noinline)) T probe_load(const unsigned char *src)
+    {
+        return make_aligned_ptr<8>(src).template load<T, 8, Mode>();
+    }
+
+    template <typename T, dereference_mode Mode>
+    __attribute__((noinline)) void probe_store(unsigned char *dest, T value)
+    {
+        make_aligned_ptr<8>(dest).template store<T, 8, Mode>(value);
+    }
+
+    // Explicit instantiations to have every probe in the disassembly
+    template unsigned short probe_load<unsigned short, dereference_mode::reinterpret>(const unsigned char *);
+    template unsigned short probe_load<unsigned short, dereference_mode::copy>(const unsigned char *);
+    template unsigned int probe_load<unsigned int, dereference_mode::reinterpret>(const unsigned char *);
+    template unsigned int probe_load<unsigned int, dereference_mode::copy>(const unsigned char *);
+    template unsigned long long probe_load<unsigned long long, dereference_mode::reinterpret>(const unsigned char *);
+    template unsigned long long probe_load<unsigned long long, dereference_mode::copy>(const unsigned char *);
+
+    template void probe_store<unsigned short, dereference_mode::reinterpret>(unsigned char *, unsigned short);
+    template void probe_store<unsigned short, dereference_mode::copy>(unsigned char *, unsigned short);
+    template void probe_store<unsigned int, dereference_mode::reinterpret>(unsigned char *, unsigned int);
+    template void probe_store<unsigned int, dereference_mode::copy>(unsigned char *, unsigned int);
+    template void probe_store<unsigned long long, dereference_mode::reinterpret>(unsigned char *, unsigned long long);
+    template void probe_store<unsigned long long, dereference_mode::copy>(unsigned char *, unsigned long long);
+
+    // Sums all words of the buffer, inlined accesses this time so the loop body is what the optimizer sees in real code.
+    template <dereference_mode Mode>
+    __attribute__((noinline)) unsigned int sum_words(const unsigned char *src, size_t count)
+    {
+        unsigned int sum = 0;
+        for (size_t i = 0; i < count; ++i)
+        {
+            sum += make_aligned_ptr<4>(src + 4 * i).template load<unsigned int, 0, Mode>();
+        }
+        return sum;
+    }
+
+    // probes_agree
+    // true iff both modes load and store the same values at offset 8 of buffer.
+    template <typename T>
+    bool probes_agree()
+    {
+        const T value = static_cast<T>(0x0123456789abcdefull);
+
+        probe_store<T, dereference_mode::reinterpret>(buffer, value);
+        const T reinterpret_loaded = probe_load<T, dereference_mode::copy>(buffer);
+        probe_store<T, dereference_mode::copy>(buffer, value);
+        const T copy_loaded = probe_load<T, dereference_mode::reinterpret>(buffer);
+
+        return reinterpret_loaded == value && copy_loaded == value;
+    }
+
+#ifdef NETSER_DEREFERENCE_BENCH_TIMING
+    template <dereference_mode Mode>
+    long long time_sum_words(unsigned int &result)
+    {
+        constexpr size_t rounds = 100000;
+        auto start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < rounds; ++i)
+        {
+            result += sum_words<Mode>(buffer, sizeof(buffer) / 4);
+        }
+        auto stop = std::chrono::steady_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count() / rounds;
+    }
+#endif
+
+} // namespace dereference_bench_detail
+
+// dereference_bench
+// Returns true iff the reinterpret and copy modes produce the same values.
+bool dereference_bench()
+{
+    using namespace dereference_bench_detail;
+
+    for (size_t i = 0; i < sizeof(buffer); ++i)
+    {
+        buffer[i] = static_cast<unsigned char>(i * 7 + 3);
+    }
+
+    const bool sums_agree = sum_words<dereference_mode::reinterpret>(buffer, sizeof(buffer) / 4)
+                            == sum_words<dereference_mode::copy>(buffer, sizeof(buffer) / 4);
+    const bool agree = sums_agree && probes_agree<unsigned short>() && probes_agree<unsigned int>() && probes_agree<unsigned long long>();
+
+#ifdef NETSER_DEREFERENCE_BENCH_TIMING
+    unsigned int result = 0;
+    auto reinterpret_ns = time_sum_words<dereference_mode::reinterpret>(result);
+    auto copy_ns = time_sum_words<dereference_mode::copy>(result);
+
+    std::cout << "dereference_bench (" << sizeof(buffer) << " bytes): reinterpret " << reinterpret_ns << " ns, copy " << copy_ns
+              << " ns (checksum " << result << ")" << (agree ? "" : ", MODES DISAGREE") << "\n";
+#endif
+
+    return agree;
+}
@@ -201,6 +201,8 @@ using announce_zipped = netser::zipped<
 
 announce_zipped default_zipped(Announce);
 
+bool dereference_bench();
+
 int main()
 {
     char buffer[128];
@@ -236,5 +238,7 @@ int main()
     Announce announce;
     fill_random(announce);
     make_aligned_ptr<4, 0, 34>(buffer) << announce;
+
+    return dereference_bench() ? 0 : 1;
 }
 
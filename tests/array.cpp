@@ -0,0 +1,105 @@
+#include "test_shared.hpp"
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct payload_struct
+{
+    unsigned char head;
+    std::array<unsigned char, 64> payload;
+};
+
+GTEST_TEST(array_test, byte_array_copy)
+{
+    alignas(8) unsigned char src[65];
+    for (size_t i = 0; i < sizeof(src); ++i)
+        src[i] = static_cast<unsigned char>(i * 7);
+
+    payload_struct dest{};
+    collect_logger log;
+
+    using payload_layout = layout<net_uint8, net_uint8[64]>;
+    using payload_mapping = mapping_list<mem<&payload_struct::head>, mem<&payload_struct::payload>>;
+
+    // The head byte, then the whole payload in a single copy
+    read<payload_layout, payload_mapping>(make_aligned_ptr<8, 0>(src, &log), dest);
+    EXPECT_EQ(dest.head, src[0]);
+    EXPECT_EQ(std::memcmp(dest.payload.data(), src + 1, 64), 0);
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_EQ(log[1].offset, 1);
+    EXPECT_EQ(log[1].size, 64);
+    log.clear();
+
+    alignas(8) unsigned char out[65] = {};
+    write<payload_layout, payload_mapping>(make_aligned_ptr<8, 0>(out, &log), dest);
+    EXPECT_EQ(std::memcmp(out, src, sizeof(src)), 0);
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_EQ(log[1].offset, 1);
+    EXPECT_EQ(log[1].size, 64);
+}
+
+GTEST_TEST(array_test, word_array_swap)
+{
+    // 100 big endian samples, starting 2 bytes into a 16 byte aligned buffer -> scalar head, vector blocks, scalar tail
+    alignas(16) unsigned char src[2 + 200];
+    for (size_t i = 0; i < 100; ++i)
+    {
+        src[2 + 2 * i] = static_cast<unsigned char>(i);
+        src[2 + 2 * i + 1] = static_cast<unsigned char>(0xff - i);
+    }
+
+    std::array<unsigned short, 100> dest{};
+    collect_logger log;
+
+    using sample_layout = layout<net_uint16[100]>;
+    using sample_mapping = mapping_list<identity>;
+
+    read<sample_layout, sample_mapping>(make_aligned_ptr<16, 2>(src + 2, &log), dest);
+    for (size_t i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(dest[i], (i << 8) | (0xff - i));
+    }
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].size, 200);
+    log.clear();
+
+    alignas(16) unsigned char out[2 + 200] = {};
+    write<sample_layout, sample_mapping>(make_aligned_ptr<16, 2>(out + 2, &log), dest);
+    EXPECT_EQ(std::memcmp(out + 2, src + 2, 200), 0);
+    ASSERT_EQ(log.size(), 1);
+}
+
+enum class lane_mode : unsigned char
+{
+    off = 0,
+    rx = 1,
+    tx = 2
+};
+
+struct lane_config
+{
+    std::array<lane_mode, 8> lanes;
+};
+
+GTEST_TEST(array_test, enum_elements)
+{
+    alignas(8) unsigned char src[8] = {0x01, 0x02, 0x00, 0x02, 0x01, 0x01, 0x00, 0x00};
+
+    using lane_layout = layout<net_uint8[8]>;
+    using lane_mapping = mapping_list<mem<&lane_config::lanes>>;
+
+    lane_config config{};
+    read<lane_layout, lane_mapping>(make_aligned_ptr<8>(src), config);
+    EXPECT_EQ(config.lanes[0], lane_mode::rx);
+    EXPECT_EQ(config.lanes[1], lane_mode::tx);
+    EXPECT_EQ(config.lanes[2], lane_mode::off);
+    EXPECT_EQ(config.lanes[3], lane_mode::tx);
+    EXPECT_EQ(config.lanes[4], lane_mode::rx);
+
+    alignas(8) unsigned char out[8] = {};
+    write<lane_layout, lane_mapping>(make_aligned_ptr<8>(out), config);
+    EXPECT_EQ(std::memcmp(out, src, sizeof(src)), 0);
+}
@@ -0,0 +1,48 @@
+#include "test_shared.hpp"
+#include <netser/batch.hpp>
+#include <array>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct sample_struct
+{
+    unsigned short id;
+    unsigned int value;
+};
+
+GTEST_TEST(batch_test, strided_round_trip)
+{
+    using sample_layout = layout<net_uint16, net_uint16, net_uint32>;
+    using sample_mapping = mapping_list<mem<&sample_struct::id>, constant<unsigned short, 0>, mem<&sample_struct::value>>;
+
+    // 6 packets (one unrolled group and a remainder), 8 bytes apart
+    std::array<sample_struct, 6> src;
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = {static_cast<unsigned short>(i), static_cast<unsigned int>(0x1000 * i + 1)};
+
+    alignas(8) unsigned char buffer[6 * 8] = {};
+    EXPECT_EQ((write_batch<sample_layout, sample_mapping, 8>(make_aligned_ptr<8>(buffer), std::span<sample_struct>(src))), 6u);
+    EXPECT_EQ(buffer[8 * 5 + 1], 5);
+    EXPECT_EQ(buffer[8 * 5 + 7], 1);
+
+    std::array<sample_struct, 6> dest{};
+    EXPECT_EQ((read_batch<sample_layout, sample_mapping, 8>(make_aligned_ptr<8>(buffer), std::span<sample_struct>(dest))), 6u);
+    for (size_t i = 0; i < dest.size(); ++i)
+    {
+        EXPECT_EQ(dest[i].id, src[i].id);
+        EXPECT_EQ(dest[i].value, src[i].value);
+    }
+
+    // Same packets through a list of buffer pointers, in reverse order
+    using ptr_type = decltype(make_aligned_ptr<8>(buffer));
+    std::array<ptr_type, 6> ptrs{ptr_type(buffer + 40), ptr_type(buffer + 32), ptr_type(buffer + 24),
+                                 ptr_type(buffer + 16), ptr_type(buffer + 8),  ptr_type(buffer)};
+    std::array<sample_struct, 6> reversed{};
+    EXPECT_EQ((read_batch<sample_layout, sample_mapping>(std::span<const ptr_type>(ptrs), std::span<sample_struct>(reversed))), 6u);
+    for (size_t i = 0; i < reversed.size(); ++i)
+    {
+        EXPECT_EQ(reversed[i].id, src[5 - i].id);
+    }
+}
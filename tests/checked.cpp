@@ -0,0 +1,124 @@
+#include "test_shared.hpp"
+#include <netser/checked.hpp>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct checked_header
+{
+    unsigned char type;
+    unsigned short length;
+    unsigned int sequence;
+};
+
+using checked_header_zipped = zipped<net_uint8, mem<&checked_header::type>, net_uint16, mem<&checked_header::length>, net_uint32,
+                                     mem<&checked_header::sequence>>;
+
+checked_header_zipped default_zipped(checked_header);
+
+GTEST_TEST(checked_test, read_length_check)
+{
+    alignas(8) std::byte packet[8] = {std::byte{0x01}, std::byte{0x00}, std::byte{0x2c}, std::byte{0xde},
+                                      std::byte{0xad}, std::byte{0xbe}, std::byte{0xef}, std::byte{0xff}};
+
+    checked_header header{};
+    auto result = read(std::span<const std::byte>(packet, 6), header);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), span_error::too_short);
+    EXPECT_EQ(header.type, 0);
+
+    result = read(std::span<const std::byte>(packet, 7), header);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, 7u);
+    EXPECT_EQ(header.type, 1);
+    EXPECT_EQ(header.length, 0x2c);
+    EXPECT_EQ(header.sequence, 0xdeadbeefu);
+
+    // Same with the plan selected by the runtime residue of the data pointer
+    for (size_t shift = 0; shift < 2; ++shift)
+    {
+        alignas(8) std::byte shifted[16] = {};
+        std::memcpy(shifted + shift, packet, 7);
+
+        checked_header other{};
+        result = read_checked<checked_header_zipped, 8>(std::span<const std::byte>(shifted + shift, 7), other);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(other.sequence, 0xdeadbeefu);
+    }
+}
+
+GTEST_TEST(checked_test, write_length_check)
+{
+    const checked_header header{0x01, 0x2c, 0xdeadbeef};
+
+    std::byte small[6] = {};
+    auto result = write(std::span<std::byte>(small), header);
+    ASSERT_FALSE(result.has_value());
+
+    // The plan never touches bytes past the layout
+    alignas(8) std::byte packet[8];
+    std::memset(packet, 0xff, sizeof(packet));
+    result = write(std::span<std::byte>(packet), header);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(*result, 7u);
+    EXPECT_EQ(packet[0], std::byte{0x01});
+    EXPECT_EQ(packet[6], std::byte{0xef});
+    EXPECT_EQ(packet[7], std::byte{0xff});
+}
+
+GTEST_TEST(checked_test, write_dispatched_alignment)
+{
+    const checked_header header{0x01, 0x2c, 0xdeadbeef};
+    const unsigned char expected[7] = {0x01, 0x00, 0x2c, 0xde, 0xad, 0xbe, 0xef};
+
+    // Every residue of the 7 byte span gets its own plan, none of them may touch the bytes around the span
+    for (size_t shift = 0; shift < 8; ++shift)
+    {
+        alignas(8) std::byte packet[24];
+        std::memset(packet, 0xff, sizeof(packet));
+
+        auto result = write_checked<checked_header_zipped, 8>(std::span<std::byte>(packet + 8 + shift, 7), header);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(*result, 7u);
+        EXPECT_EQ(std::memcmp(packet + 8 + shift, expected, 7), 0) << "shift " << shift;
+        EXPECT_EQ(packet[8 + shift - 1], std::byte{0xff}) << "shift " << shift;
+        EXPECT_EQ(packet[8 + shift + 7], std::byte{0xff}) << "shift " << shift;
+
+        checked_header other{};
+        result = read_checked<checked_header_zipped, 8>(std::span<const std::byte>(packet + 8 + shift, 7), other);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(other.type, 0x01);
+        EXPECT_EQ(other.length, 0x2c);
+        EXPECT_EQ(other.sequence, 0xdeadbeefu);
+    }
+}
+
+GTEST_TEST(checked_test, span_overloads_dispatch)
+{
+    const checked_header header{0x01, 0x2c, 0xdeadbeef};
+    const unsigned char expected[7] = {0x01, 0x00, 0x2c, 0xde, 0xad, 0xbe, 0xef};
+
+    // read( span ) and write( span ) pick the plan of the runtime residue as well
+    for (size_t shift = 0; shift < detail::span_alignment; ++shift)
+    {
+        alignas(detail::span_alignment) std::byte packet[3 * detail::span_alignment];
+        std::memset(packet, 0xff, sizeof(packet));
+        std::byte *data = packet + detail::span_alignment + shift;
+
+        auto result = write(std::span<std::byte>(data, 7), header);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(std::memcmp(data, expected, 7), 0) << "shift " << shift;
+        EXPECT_EQ(data[-1], std::byte{0xff}) << "shift " << shift;
+        EXPECT_EQ(data[7], std::byte{0xff}) << "shift " << shift;
+
+        checked_header other{};
+        result = read(std::span<const std::byte>(data, 7), other);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(other.length, 0x2c);
+        EXPECT_EQ(other.sequence, 0xdeadbeefu);
+    }
+}
@@ -0,0 +1,184 @@
+#include "test_shared.hpp"
+#include <netser/checksum.hpp>
+#include <array>
+#include <cstring>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct ipv4_header
+{
+    unsigned char version;
+    unsigned char ihl;
+    unsigned char tos;
+    unsigned short total_length;
+    unsigned short id;
+    unsigned char flags;
+    unsigned short fragment_offset;
+    unsigned char ttl;
+    unsigned char protocol;
+    unsigned short checksum;
+    unsigned int source;
+    unsigned int destination;
+};
+
+using ipv4_zipped = zipped<net_uint<4>, mem<&ipv4_header::version>, net_uint<4>, mem<&ipv4_header::ihl>, net_uint8,
+                           mem<&ipv4_header::tos>, net_uint16, mem<&ipv4_header::total_length>, net_uint16, mem<&ipv4_header::id>,
+                           net_uint<3>, mem<&ipv4_header::flags>, net_uint<13>, mem<&ipv4_header::fragment_offset>, net_uint8,
+                           mem<&ipv4_header::ttl>, net_uint8, mem<&ipv4_header::protocol>,
+                           checksum_field<internet_checksum, net_uint16>, mem<&ipv4_header::checksum>, net_uint32,
+                           mem<&ipv4_header::source>, net_uint32, mem<&ipv4_header::destination>>;
+
+struct crc_record
+{
+    unsigned int sequence;
+    unsigned short length;
+    unsigned int crc;
+};
+
+using crc_record_zipped = zipped<net_uint32, mem<&crc_record::sequence>, net_uint16, mem<&crc_record::length>,
+                                 checksum_field<crc32c, net_uint32>, mem<&crc_record::crc>>;
+
+GTEST_TEST(checksum_test, algorithms)
+{
+    const char digits[] = "123456789";
+
+    crc32c crc;
+    crc.update(reinterpret_cast<const unsigned char *>(digits), 9, 0);
+    EXPECT_EQ(crc.finish(), 0xe3069283u);
+
+    // Split updates give the same result
+    crc32c split;
+    split.update(reinterpret_cast<const unsigned char *>(digits), 4, 0);
+    split.update(reinterpret_cast<const unsigned char *>(digits) + 4, 5, 4);
+    EXPECT_EQ(split.finish(), 0xe3069283u);
+
+    const unsigned char words[] = {0x00, 0x01, 0xf2, 0x03, 0xf4, 0xf5, 0xf6, 0xf7};
+    internet_checksum sum;
+    sum.update(words, 3, 0);
+    sum.update(words + 3, 5, 3);
+    EXPECT_EQ(sum.finish(), 0x220d);
+}
+
+GTEST_TEST(checksum_test, ipv4_header)
+{
+    const unsigned char expected[20] = {0x45, 0x00, 0x00, 0x73, 0x00, 0x00, 0x40, 0x00, 0x40, 0x11,
+                                        0xb8, 0x61, 0xc0, 0xa8, 0x00, 0x01, 0xc0, 0xa8, 0x00, 0xc7};
+
+    const ipv4_header header{4, 5, 0, 0x73, 0, 2, 0, 0x40, 0x11, 0, 0xc0a80001, 0xc0a800c7};
+
+    alignas(8) unsigned char packet[24] = {};
+    EXPECT_EQ(write_checksummed<ipv4_zipped>(make_aligned_ptr<8>(packet), header), 0xb861);
+    EXPECT_EQ(std::memcmp(packet, expected, sizeof(expected)), 0);
+
+    ipv4_header read_back{};
+    EXPECT_TRUE(read_checksummed<ipv4_zipped>(make_aligned_ptr<8>(packet), read_back));
+    EXPECT_EQ(read_back.checksum, 0xb861);
+    EXPECT_EQ(read_back.destination, 0xc0a800c7u);
+
+    packet[15] ^= 0x01;
+    EXPECT_FALSE(read_checksummed<ipv4_zipped>(make_aligned_ptr<8>(packet), read_back));
+}
+
+GTEST_TEST(checksum_test, crc_trailer)
+{
+    const crc_record record{0xdeadbeef, 0x1234, 0};
+
+    alignas(8) unsigned char packet[16] = {};
+    const auto written = write_checksummed<crc_record_zipped>(make_aligned_ptr<8>(packet), record);
+
+    crc32c expected;
+    expected.update(packet, 6, 0);
+    EXPECT_EQ(written, expected.finish());
+    EXPECT_EQ(packet[6], static_cast<unsigned char>(written >> 24));
+    EXPECT_EQ(packet[9], static_cast<unsigned char>(written));
+
+    crc_record read_back{};
+    EXPECT_TRUE(read_checksummed<crc_record_zipped>(make_aligned_ptr<8>(packet), read_back));
+    EXPECT_EQ(read_back.crc, written);
+
+    packet[2] ^= 0x80;
+    EXPECT_FALSE(read_checksummed<crc_record_zipped>(make_aligned_ptr<8>(packet), read_back));
+}
+
+GTEST_TEST(checksum_test, internet_checksum_split)
+{
+    unsigned char data[23];
+    for (size_t i = 0; i < sizeof(data); ++i)
+    {
+        data[i] = static_cast<unsigned char>(0x9d * i + 0x31);
+    }
+
+    internet_checksum whole;
+    whole.update(data, sizeof(data), 0);
+
+    // Word sums of any split, at even or odd offsets, give the same result
+    for (size_t split = 0; split <= sizeof(data); ++split)
+    {
+        internet_checksum parts;
+        parts.update(data, split, 0);
+        parts.update(data + split, sizeof(data) - split, split);
+        EXPECT_EQ(parts.finish(), whole.finish()) << "split " << split;
+    }
+}
+
+GTEST_TEST(checksum_test, single_checksum_read)
+{
+    const crc_record record{0xdeadbeef, 0x1234, 0};
+    alignas(8) unsigned char packet[16] = {};
+    write_checksummed<crc_record_zipped>(make_aligned_ptr<8>(packet), record);
+
+    crc_record read_back{};
+    collect_logger log;
+    EXPECT_TRUE(read_checksummed<crc_record_zipped>(make_aligned_ptr<1>(packet, &log), read_back));
+
+    // Byte loads for the 10 bytes of the record, the stored checksum is loaded once
+    size_t byte_loads = 0;
+    for (size_t i = 0; i < log.size(); ++i)
+    {
+        byte_loads += log[i].size == 1 ? 1 : 0;
+    }
+    EXPECT_EQ(byte_loads, 10u);
+}
+
+struct mixed_record
+{
+    unsigned char kind;
+    unsigned short length;
+    unsigned short flags;
+    std::array<unsigned char, 8> tag;
+    unsigned short checksum;
+    unsigned int sequence;
+};
+
+using mixed_zipped = zipped<net_uint<4>, mem<&mixed_record::kind>, net_uint<12>, mem<&mixed_record::length>,
+                            int_<false, 16, byte_order::le>, mem<&mixed_record::flags>, net_uint8[8], mem<&mixed_record::tag>,
+                            checksum_field<internet_checksum, net_uint16>, mem<&mixed_record::checksum>, net_uint32,
+                            mem<&mixed_record::sequence>>;
+
+GTEST_TEST(checksum_test, mixed_leaves)
+{
+    const mixed_record record{0xa, 0x5c3, 0x1234, {0x81, 0x92, 0xa3, 0xb4, 0xc5, 0xd6, 0xe7, 0xf8}, 0, 0xdeadbeef};
+
+    // The integer spans are summed from their loaded or stored words, the array from memory, at any alignment
+    alignas(8) unsigned char packet[24] = {};
+    const auto written = write_checksummed<mixed_zipped>(make_aligned_ptr<8>(packet), record);
+
+    internet_checksum expected;
+    expected.update(packet, 12, 0);
+    expected.update(packet + 14, 4, 14);
+    EXPECT_EQ(written, expected.finish());
+
+    alignas(8) unsigned char shifted[24] = {};
+    EXPECT_EQ(write_checksummed<mixed_zipped>(make_aligned_ptr<1>(shifted + 1), record), written);
+
+    mixed_record read_back{};
+    EXPECT_TRUE(read_checksummed<mixed_zipped>(make_aligned_ptr<8>(packet), read_back));
+    EXPECT_EQ(read_back.flags, 0x1234);
+    EXPECT_TRUE(read_checksummed<mixed_zipped>(make_aligned_ptr<1>(shifted + 1), read_back));
+    EXPECT_EQ(read_back.checksum, written);
+
+    shifted[3] ^= 0x10;
+    EXPECT_FALSE(read_checksummed<mixed_zipped>(make_aligned_ptr<1>(shifted + 1), read_back));
+}
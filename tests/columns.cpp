@@ -0,0 +1,36 @@
+#include "test_shared.hpp"
+#include <netser/columns.hpp>
+#include <array>
+#include <span>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct sample_columns
+{
+    std::span<unsigned short> id;
+    std::span<unsigned int> value;
+};
+
+GTEST_TEST(columns_test, strided_round_trip)
+{
+    using sample_layout = layout<net_uint16, net_uint16, net_uint32>;
+    using sample_mapping = mapping_list<column<&sample_columns::id>, constant<unsigned short, 0>, column<&sample_columns::value>>;
+
+    std::array<unsigned short, 5> ids{10, 11, 12, 13, 14};
+    std::array<unsigned int, 5> values{0x100, 0x200, 0x300, 0x400, 0x500};
+    sample_columns src{ids, values};
+
+    alignas(8) unsigned char buffer[5 * 8] = {};
+    EXPECT_EQ((write_columns<sample_layout, sample_mapping, 8>(make_aligned_ptr<8>(buffer), src, 5)), 5u);
+    EXPECT_EQ(buffer[8 * 4 + 1], 14);
+    EXPECT_EQ(buffer[8 * 4 + 6], 0x05);
+
+    std::array<unsigned short, 5> read_ids{};
+    std::array<unsigned int, 5> read_values{};
+    sample_columns dest{read_ids, read_values};
+    EXPECT_EQ((read_columns<sample_layout, sample_mapping, 8>(make_aligned_ptr<8>(buffer), dest, 5)), 5u);
+    EXPECT_EQ(read_ids, ids);
+    EXPECT_EQ(read_values, values);
+}
@@ -0,0 +1,107 @@
+#include "test_shared.hpp"
+#include <netser/dynamic_array.hpp>
+#include <netser/validate.hpp>
+#include <array>
+#include <cstring>
+#include <vector>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct path_trace
+{
+    unsigned short length;
+    std::array<unsigned short, 8> path;
+    unsigned short trailer;
+};
+
+using path_trace_layout = layout<net_uint16, dynamic_array<&path_trace::length, net_uint16, 8>, net_uint16>;
+using path_trace_mapping = mapping_list<mem<&path_trace::length>, mem<&path_trace::path>, mem<&path_trace::trailer>>;
+
+GTEST_TEST(dynamic_array_test, length_prefixed_read_write)
+{
+    alignas(8) unsigned char src[10] = {0x00, 0x03, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0xbe, 0xef};
+
+    path_trace trace{};
+    auto end = read_inline<path_trace_layout, path_trace_mapping>(make_aligned_ptr<8>(src), trace);
+
+    EXPECT_EQ(trace.length, 3);
+    EXPECT_EQ(trace.path[0], 0x0102);
+    EXPECT_EQ(trace.path[1], 0x0304);
+    EXPECT_EQ(trace.path[2], 0x0506);
+    EXPECT_EQ(trace.path[3], 0);
+    EXPECT_EQ(trace.trailer, 0xbeef);
+
+    // Behind the dynamic part only the residue modulo the element size is known
+    EXPECT_EQ(decltype(end)::get_max_alignment(), 2u);
+
+    alignas(8) unsigned char out[10] = {};
+    write_inline<path_trace_layout, path_trace_mapping>(make_aligned_ptr<8>(out), trace);
+    EXPECT_EQ(std::memcmp(out, src, sizeof(src)), 0);
+}
+
+struct path_trace_vector
+{
+    unsigned short length;
+    std::vector<unsigned short> path;
+    unsigned short trailer;
+};
+
+GTEST_TEST(dynamic_array_test, resizable_storage)
+{
+    alignas(8) unsigned char src[8] = {0x00, 0x02, 0x01, 0x02, 0x03, 0x04, 0xbe, 0xef};
+
+    using vector_layout = layout<net_uint16, dynamic_array<&path_trace_vector::length, net_uint16, 8>, net_uint16>;
+    using vector_mapping = mapping_list<mem<&path_trace_vector::length>, mem<&path_trace_vector::path>, mem<&path_trace_vector::trailer>>;
+
+    path_trace_vector trace{};
+    read<vector_layout, vector_mapping>(make_aligned_ptr<8>(src), trace);
+
+    ASSERT_EQ(trace.path.size(), 2u);
+    EXPECT_EQ(trace.path[0], 0x0102);
+    EXPECT_EQ(trace.path[1], 0x0304);
+    EXPECT_EQ(trace.trailer, 0xbeef);
+}
+
+GTEST_TEST(dynamic_array_test, count_above_bound)
+{
+    using path_trace_zipped = zipped<net_uint16, mem<&path_trace::length>, dynamic_array<&path_trace::length, net_uint16, 8>,
+                                     mem<&path_trace::path>, net_uint16, mem<&path_trace::trailer>>;
+
+    // The count claims 9 elements, one more than the array can hold
+    alignas(8) unsigned char src[22] = {0x00, 0x09, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a,
+                                        0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10, 0x11, 0x12, 0xbe, 0xef};
+
+    path_trace trace{};
+    EXPECT_EQ(read_validated<path_trace_zipped>(make_aligned_ptr<8>(src), trace), validation_errors(count_out_of_range));
+    EXPECT_EQ(trace.length, 9);
+    EXPECT_EQ(trace.path[0], 0);
+
+    // A count within the bound is no error
+    src[1] = 0x08;
+    EXPECT_EQ(read_validated<path_trace_zipped>(make_aligned_ptr<8>(src), trace), 0u);
+    EXPECT_EQ(trace.path[7], 0x0f10);
+    EXPECT_EQ(trace.trailer, 0x1112);
+
+    // Unchecked reads and writes take a valid count as precondition
+    src[1] = 0x09;
+    EXPECT_DEBUG_DEATH((read<path_trace_layout, path_trace_mapping>(make_aligned_ptr<8>(src), trace)), "");
+
+    trace.length = 9;
+    alignas(8) unsigned char out[22];
+    EXPECT_DEBUG_DEATH((write<path_trace_layout, path_trace_mapping>(make_aligned_ptr<8>(out), trace)), "");
+}
+
+GTEST_TEST(dynamic_array_test, short_storage)
+{
+    using vector_layout = layout<net_uint16, dynamic_array<&path_trace_vector::length, net_uint16, 8>, net_uint16>;
+    using vector_mapping = mapping_list<mem<&path_trace_vector::length>, mem<&path_trace_vector::path>, mem<&path_trace_vector::trailer>>;
+
+    // The count asks for more elements than the storage holds
+    path_trace_vector trace{3, {0x0102}, 0xbeef};
+    alignas(8) unsigned char out[10];
+
+    EXPECT_DEBUG_DEATH((write<vector_layout, vector_mapping>(make_aligned_ptr<8>(out), trace)), "");
+    EXPECT_EQ(trace.path.size(), 1u);
+}
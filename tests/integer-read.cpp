@@ -1,5 +1,6 @@
 #include "test_shared.hpp"
 #include <gtest/gtest.h>
+#include <cstring>
 
 
 using namespace netser;
@@ -99,3 +100,167 @@ GTEST_TEST(integer_test, single_read16_defect_range)
         log.clear();
     }
 }
+
+struct span_struct
+{
+    unsigned char a;
+    unsigned char b;
+    unsigned short c;
+};
+
+GTEST_TEST(integer_test, span_read_shared_load)
+{
+    alignas(4) unsigned char src[] = {0x12, 0x34, 0x56, 0x78};
+    span_struct dest;
+    collect_logger log;
+
+    using span_layout = layout<net_uint8, net_uint8, net_uint16>;
+    using span_mapping = mapping_list<mem<&span_struct::a>, mem<&span_struct::b>, mem<&span_struct::c>>;
+
+    // All three fields are extracted from a single dword
+    read<span_layout, span_mapping>(make_aligned_ptr<4, 0>(src, &log), dest);
+    EXPECT_EQ(dest.a, 0x12);
+    EXPECT_EQ(dest.b, 0x34);
+    EXPECT_EQ(dest.c, 0x5678);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 4);
+    log.clear();
+
+    // Two words, the 16 bit field does not need its own access
+    read<span_layout, span_mapping>(make_aligned_ptr<2, 0>(src, &log), dest);
+    EXPECT_EQ(dest.a, 0x12);
+    EXPECT_EQ(dest.b, 0x34);
+    EXPECT_EQ(dest.c, 0x5678);
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_TRUE(log[0].offset == 0 && log[0].size == 2);
+    EXPECT_TRUE(log[1].offset == 2 && log[1].size == 2);
+    log.clear();
+}
+
+struct nibble_struct
+{
+    unsigned char a;
+    unsigned char b;
+    unsigned int c;
+};
+
+GTEST_TEST(integer_test, span_read_sub_byte)
+{
+    alignas(4) unsigned char src[] = {0x12, 0x34, 0x56, 0x78};
+    nibble_struct dest;
+    collect_logger log;
+
+    // The 20 bit field straddles the word boundary at alignment 2
+    using nibble_layout = layout<net_uint<4>, net_uint<8>, net_uint<20>>;
+    using nibble_mapping = mapping_list<mem<&nibble_struct::a>, mem<&nibble_struct::b>, mem<&nibble_struct::c>>;
+
+    read<nibble_layout, nibble_mapping>(make_aligned_ptr<4, 0>(src, &log), dest);
+    EXPECT_EQ(dest.a, 0x1);
+    EXPECT_EQ(dest.b, 0x23);
+    EXPECT_EQ(dest.c, 0x45678u);
+    ASSERT_EQ(log.size(), 1);
+    log.clear();
+
+    read<nibble_layout, nibble_mapping>(make_aligned_ptr<2, 0>(src, &log), dest);
+    EXPECT_EQ(dest.a, 0x1);
+    EXPECT_EQ(dest.b, 0x23);
+    EXPECT_EQ(dest.c, 0x45678u);
+    ASSERT_EQ(log.size(), 2);
+    log.clear();
+}
+
+struct le_span_struct
+{
+    unsigned short a;
+    unsigned short b;
+    unsigned int c;
+};
+
+GTEST_TEST(integer_test, span_read_little_endian)
+{
+    alignas(8) unsigned char src[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    le_span_struct dest{};
+    collect_logger log;
+
+    using le_layout = layout<int_<false, 16, byte_order::le>, int_<false, 16, byte_order::le>, int_<false, 32, byte_order::le>>;
+    using le_mapping = mapping_list<mem<&le_span_struct::a>, mem<&le_span_struct::b>, mem<&le_span_struct::c>>;
+
+    // All fields share one load, each keeps its own byte order
+    read<le_layout, le_mapping>(make_aligned_ptr<8, 0>(src, &log), dest);
+    EXPECT_EQ(dest.a, 0x0201);
+    EXPECT_EQ(dest.b, 0x0403);
+    EXPECT_EQ(dest.c, 0x08070605u);
+    EXPECT_EQ(log.size(), 1);
+    log.clear();
+
+    // Byte loads assemble the fields in the same order
+    dest = {};
+    read<le_layout, le_mapping>(make_aligned_ptr<1, 0>(src, &log), dest);
+    EXPECT_EQ(dest.a, 0x0201);
+    EXPECT_EQ(dest.b, 0x0403);
+    EXPECT_EQ(dest.c, 0x08070605u);
+    EXPECT_EQ(log.size(), 8);
+}
+
+GTEST_TEST(integer_test, dereference_modes)
+{
+    alignas(8) unsigned char buffer[16] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08,
+                                           0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f, 0x10};
+    auto ptr = make_aligned_ptr<8>(buffer);
+
+    EXPECT_EQ((ptr.load<unsigned short, 2, dereference_mode::reinterpret>()), (ptr.load<unsigned short, 2, dereference_mode::copy>()));
+    EXPECT_EQ((ptr.load<unsigned int, 4, dereference_mode::reinterpret>()), (ptr.load<unsigned int, 4, dereference_mode::copy>()));
+    EXPECT_EQ((ptr.load<unsigned long long, 8, dereference_mode::reinterpret>()),
+              (ptr.load<unsigned long long, 8, dereference_mode::copy>()));
+
+    // Stores of either mode are read back by the other
+    ptr.store<unsigned long long, 8, dereference_mode::reinterpret>(0x1122334455667788ull);
+    EXPECT_EQ((ptr.load<unsigned long long, 8, dereference_mode::copy>()), 0x1122334455667788ull);
+    ptr.store<unsigned int, 4, dereference_mode::copy>(0xcafef00du);
+    EXPECT_EQ((ptr.load<unsigned int, 4, dereference_mode::reinterpret>()), 0xcafef00du);
+
+    // Misaligned offsets are always copied
+    unsigned int expected;
+    std::memcpy(&expected, buffer + 3, sizeof(expected));
+    EXPECT_EQ((ptr.load<unsigned int, 3>()), expected);
+
+    ptr.store<unsigned short, 5, dereference_mode::copy>(0xbeef);
+    unsigned short stored;
+    std::memcpy(&stored, buffer + 5, sizeof(stored));
+    EXPECT_EQ(stored, 0xbeef);
+}
+
+GTEST_TEST(integer_test, runtime_alignment_dispatch)
+{
+    alignas(8) unsigned char src[12] = {};
+    collect_logger log;
+
+    for (size_t shift = 0; shift < 8; ++shift)
+    {
+        src[shift] = 0x12;
+        src[shift + 1] = 0x34;
+        src[shift + 2] = 0x56;
+        src[shift + 3] = 0x78;
+
+        uint32_t dest = 0;
+        const size_t defect = dispatch_aligned<8>(
+            src + shift,
+            [&](auto ptr) {
+                read<layout<net_uint32>, mapping_list<identity>>(ptr, dest);
+                return decltype(ptr)::get_pointer_defect();
+            },
+            &log);
+
+        EXPECT_EQ(defect, shift);
+        EXPECT_EQ(dest, 0x12345678u);
+
+        // Aligned residues get a single load
+        if (shift % 4 == 0)
+        {
+            EXPECT_EQ(log.size(), 1);
+        }
+        log.clear();
+        std::memset(src, 0, sizeof(src));
+    }
+}
@@ -1,4 +1,5 @@
 #include "test_shared.hpp"
+#include <cstring>
 #include <gtest/gtest.h>
 
 
@@ -135,3 +136,70 @@ GTEST_TEST(integer_test, single_write48)
     dest = 0;
     log.clear();
 }
+
+struct span_struct
+{
+    unsigned char a;
+    unsigned char b;
+    unsigned short c;
+};
+
+GTEST_TEST(integer_test, span_write_shared_store)
+{
+    span_struct src{0x12, 0x34, 0x5678};
+    const unsigned char expected[4] = {0x12, 0x34, 0x56, 0x78};
+    alignas(4) unsigned char dest[4] = {};
+    collect_logger log;
+
+    using span_layout = layout<net_uint8, net_uint8, net_uint16>;
+    using span_mapping = mapping_list<mem<&span_struct::a>, mem<&span_struct::b>, mem<&span_struct::c>>;
+
+    // All three fields of different sizes are collected into a single dword
+    write<span_layout, span_mapping>(make_aligned_ptr<4, 0>(dest, &log), src);
+    EXPECT_EQ(std::memcmp(dest, expected, 4), 0);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 4);
+    std::memset(dest, 0, 4);
+    log.clear();
+
+    // Alignment == 2 -> two words
+    write<span_layout, span_mapping>(make_aligned_ptr<2, 0>(dest, &log), src);
+    EXPECT_EQ(std::memcmp(dest, expected, 4), 0);
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 2);
+    EXPECT_EQ(log[1].offset, 2);
+    EXPECT_EQ(log[1].size, 2);
+    log.clear();
+}
+
+struct le_span_struct
+{
+    unsigned short a;
+    unsigned short b;
+    unsigned int c;
+};
+
+GTEST_TEST(integer_test, span_write_little_endian)
+{
+    le_span_struct src{0x0201, 0x0403, 0x08070605u};
+    const unsigned char expected[8] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+    alignas(8) unsigned char dest[8] = {};
+    collect_logger log;
+
+    using le_layout = layout<int_<false, 16, byte_order::le>, int_<false, 16, byte_order::le>, int_<false, 32, byte_order::le>>;
+    using le_mapping = mapping_list<mem<&le_span_struct::a>, mem<&le_span_struct::b>, mem<&le_span_struct::c>>;
+
+    // All fields share one store, each keeps its own byte order
+    write<le_layout, le_mapping>(make_aligned_ptr<8, 0>(dest, &log), src);
+    EXPECT_EQ(std::memcmp(dest, expected, 8), 0);
+    EXPECT_EQ(log.size(), 1);
+    std::memset(dest, 0, 8);
+    log.clear();
+
+    // Byte stores lay out the fields in the same order
+    write<le_layout, le_mapping>(make_aligned_ptr<1, 0>(dest, &log), src);
+    EXPECT_EQ(std::memcmp(dest, expected, 8), 0);
+    EXPECT_EQ(log.size(), 8);
+}
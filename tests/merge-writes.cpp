@@ -0,0 +1,47 @@
+#define NETSER_MERGE_WRITES
+#include "test_shared.hpp"
+#include <cstring>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+GTEST_TEST(merge_writes_test, bounded_range)
+{
+    unsigned int src = 0x123456;
+    const unsigned char expected[4] = {0x12, 0x34, 0x56, 0xaa};
+    alignas(4) unsigned char dest[4] = {0xaa, 0xaa, 0xaa, 0xaa};
+    collect_logger log;
+
+    using u24_layout = layout<net_uint<24>>;
+    using u24_mapping = mapping_list<identity>;
+
+    // The range covers the byte behind the span, so the 3 bytes are merged into one dword load and store
+    write<u24_layout, u24_mapping>(make_aligned_ptr<4, 0, 0, bounded<0, 5>>(dest, &log), src);
+    EXPECT_EQ(std::memcmp(dest, expected, 4), 0);
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 4);
+    EXPECT_EQ(log[1].offset, 0);
+    EXPECT_EQ(log[1].size, 4);
+}
+
+GTEST_TEST(merge_writes_test, unbounded_range)
+{
+    unsigned int src = 0x123456;
+    const unsigned char expected[4] = {0x12, 0x34, 0x56, 0xaa};
+    alignas(4) unsigned char dest[4] = {0xaa, 0xaa, 0xaa, 0xaa};
+    collect_logger log;
+
+    using u24_layout = layout<net_uint<24>>;
+    using u24_mapping = mapping_list<identity>;
+
+    // Without an upper bound the byte behind the span might not exist, so nothing past the span is touched
+    write<u24_layout, u24_mapping>(make_aligned_ptr<4, 0>(dest, &log), src);
+    EXPECT_EQ(std::memcmp(dest, expected, 4), 0);
+    ASSERT_EQ(log.size(), 2);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 2);
+    EXPECT_EQ(log[1].offset, 2);
+    EXPECT_EQ(log[1].size, 1);
+}
@@ -12,6 +12,7 @@
 #endif
 
 #include <netser/platform_toolkit.hpp>
+#include <netser/platform_profiles.hpp>
 #include <netser/utility.hpp>
 #include <meta/tlist.hpp>
 
@@ -29,11 +30,16 @@ namespace netser
     template <typename T>
     using byte_swap_wrapper = platform_generic_wrapper<T>;
 
+    // A test may plan against one of the ready-made profiles by defining NETSER_TEST_PROFILE before any include.
+#ifdef NETSER_TEST_PROFILE
+    using platform_memory_accesses = profiles::NETSER_TEST_PROFILE;
+#else
     using platform_memory_accesses = meta::tlist<
         atomic_memory_access<unsigned char, 1, 1, byte_order::little_endian>,
         atomic_memory_access<unsigned short, 2, 2, byte_order::little_endian>,
         atomic_memory_access<unsigned int, 4, 4, byte_order::little_endian>,
         atomic_memory_access<uint64, 8, 8, byte_order::little_endian>
     >;
+#endif
 
 } // namespace netser
@@ -0,0 +1,92 @@
+#include "test_shared.hpp"
+#include <netser/optional_field.hpp>
+#include <cstring>
+#include <optional>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct sync_message
+{
+    unsigned char flags;
+    std::optional<unsigned int> extension;
+    unsigned short sequence_id;
+};
+
+using sync_zipped = zipped<net_uint8, mem<&sync_message::flags>,
+                           optional_field<flag_set<&sync_message::flags, 0x04>, net_uint32>, mem<&sync_message::extension>,
+                           net_uint16, mem<&sync_message::sequence_id>>;
+
+GTEST_TEST(optional_field_test, present)
+{
+    alignas(8) unsigned char src[8] = {0x04, 0xde, 0xad, 0xbe, 0xef, 0x12, 0x34, 0x00};
+
+    sync_message message{};
+    read_zipped<sync_zipped>(make_aligned_ptr<8>(src), message);
+
+    ASSERT_TRUE(message.extension.has_value());
+    EXPECT_EQ(*message.extension, 0xdeadbeefu);
+    EXPECT_EQ(message.sequence_id, 0x1234);
+
+    alignas(8) unsigned char out[8] = {};
+    write_zipped<sync_zipped>(make_aligned_ptr<8>(out), message);
+    EXPECT_EQ(std::memcmp(out, src, sizeof(src)), 0);
+}
+
+GTEST_TEST(optional_field_test, absent)
+{
+    alignas(8) unsigned char src[8] = {0x01, 0x12, 0x34};
+
+    sync_message message{0, 0x1u, 0};
+    read_zipped<sync_zipped>(make_aligned_ptr<8>(src), message);
+
+    EXPECT_FALSE(message.extension.has_value());
+    EXPECT_EQ(message.sequence_id, 0x1234);
+
+    // The extension is not written, even if the host object holds one
+    message.extension = 0xffffffffu;
+    alignas(8) unsigned char out[8] = {};
+    write_zipped<sync_zipped>(make_aligned_ptr<8>(out), message);
+    EXPECT_EQ(std::memcmp(out, src, sizeof(src)), 0);
+}
+
+struct tagged_message
+{
+    unsigned char flags;
+    std::optional<unsigned char> tag;
+    unsigned short sequence_id;
+};
+
+using tagged_zipped = zipped<net_uint8, mem<&tagged_message::flags>, optional_field<flag_set<&tagged_message::flags, 0x01>, net_uint8>,
+                             mem<&tagged_message::tag>, net_uint16, mem<&tagged_message::sequence_id>>;
+
+GTEST_TEST(optional_field_test, static_plan_behind)
+{
+    alignas(8) unsigned char present[4] = {0x01, 0x7f, 0x12, 0x34};
+    alignas(8) unsigned char absent[4] = {0x00, 0x12, 0x34, 0x00};
+    collect_logger log;
+
+    // With the tag, the sequence id is 2 aligned and read with one access. A runtime offset would only leave byte accesses.
+    tagged_message message{};
+    read_zipped<tagged_zipped>(make_aligned_ptr<8>(present, &log), message);
+    EXPECT_EQ(*message.tag, 0x7f);
+    EXPECT_EQ(message.sequence_id, 0x1234);
+    ASSERT_EQ(log.size(), 3u);
+    EXPECT_EQ(log[2].size, 2);
+    log.clear();
+
+    // Without it, the sequence id is still read with one aligned access
+    read_zipped<tagged_zipped>(make_aligned_ptr<8>(absent, &log), message);
+    EXPECT_FALSE(message.tag.has_value());
+    EXPECT_EQ(message.sequence_id, 0x1234);
+    EXPECT_EQ(log.size(), 2u);
+    log.clear();
+
+    alignas(8) unsigned char out[4] = {};
+    message = {0x01, 0x7f, 0x1234};
+    write_zipped<tagged_zipped>(make_aligned_ptr<8>(out, &log), message);
+    EXPECT_EQ(std::memcmp(out, present, sizeof(out)), 0);
+    ASSERT_EQ(log.size(), 3u);
+    EXPECT_EQ(log[2].size, 2);
+}
@@ -0,0 +1,92 @@
+#include "test_shared.hpp"
+#include <netser/packet_template.hpp>
+#include <cstring>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct sync_message
+{
+    unsigned char transport;
+    unsigned char type;
+    unsigned char version;
+    unsigned short length;
+    unsigned char domain;
+    unsigned short sequence;
+    unsigned int timestamp;
+};
+
+using sync_message_zipped
+    = zipped<net_uint<4>, mem<&sync_message::transport>, net_uint<4>, mem<&sync_message::type>, reserved<4>, net_uint<4>,
+             mem<&sync_message::version>, net_uint16, mem<&sync_message::length>, net_uint8, mem<&sync_message::domain>, reserved<8>,
+             net_uint16, mem<&sync_message::sequence>, reserved<16>, net_uint32, mem<&sync_message::timestamp>>;
+
+GTEST_TEST(packet_template_test, variable_leaves)
+{
+    using plan = detail::template_plan<sync_message_zipped, &sync_message::type, &sync_message::sequence>;
+
+    // transport shares its byte with type, the rest stays in the image
+    constexpr std::array<bool, 10> expected = {true, true, false, false, false, false, false, true, false, false};
+    EXPECT_EQ(plan::variable, expected);
+}
+
+GTEST_TEST(packet_template_test, encode_matches_full_write)
+{
+    sync_message msg{1, 0, 2, 44, 7, 0, 0};
+    packet_template<sync_message_zipped, &sync_message::sequence, &sync_message::timestamp> sync_template(msg);
+
+    for (unsigned short sequence = 0; sequence < 3; ++sequence)
+    {
+        msg.sequence = sequence;
+        msg.timestamp = 0x01020304u * sequence;
+
+        alignas(8) unsigned char encoded[16];
+        alignas(8) unsigned char written[16];
+        std::memset(encoded, 0xff, sizeof(encoded));
+        std::memset(written, 0xff, sizeof(written));
+
+        sync_template.encode(make_aligned_ptr<8>(encoded), msg);
+        write_zipped<sync_message_zipped>(make_aligned_ptr<8>(written), msg);
+        EXPECT_EQ(std::memcmp(encoded, written, sizeof(encoded)), 0);
+    }
+
+    // Fields outside the variable spans come from the image until it is updated
+    msg.domain = 9;
+    alignas(8) unsigned char encoded[16] = {};
+    sync_template.encode(make_aligned_ptr<8>(encoded), msg);
+    EXPECT_EQ(encoded[4], 7);
+
+    sync_template.update(msg);
+    sync_template.encode(make_aligned_ptr<8>(encoded), msg);
+    EXPECT_EQ(encoded[4], 9);
+}
+
+GTEST_TEST(packet_template_test, each_byte_stored_once)
+{
+    sync_message msg{1, 0, 2, 44, 7, 0x1234, 0x01020304u};
+    packet_template<sync_message_zipped, &sync_message::sequence, &sync_message::timestamp> sync_template(msg);
+
+    alignas(8) unsigned char encoded[16] = {};
+    collect_logger log;
+    sync_template.encode(make_aligned_ptr<8>(encoded, &log), msg);
+
+    // The image runs [0, 6) and [8, 10) are copied, the variable spans are stored from msg, nothing twice
+    unsigned stores[14] = {};
+    for (size_t i = 0; i < log.size(); ++i)
+    {
+        for (size_t byte = size_t(log[i].offset); byte < size_t(log[i].offset) + log[i].size; ++byte)
+        {
+            ASSERT_LT(byte, 14u);
+            ++stores[byte];
+        }
+    }
+    for (size_t byte = 0; byte < 14; ++byte)
+    {
+        EXPECT_EQ(stores[byte], 1u) << "byte " << byte;
+    }
+
+    alignas(8) unsigned char written[16] = {};
+    write_zipped<sync_message_zipped>(make_aligned_ptr<8>(written), msg);
+    EXPECT_EQ(std::memcmp(encoded, written, sizeof(encoded)), 0);
+}
@@ -0,0 +1,141 @@
+#include "test_shared.hpp"
+#include <netser/packet_view.hpp>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct view_header
+{
+    unsigned char transport;
+    unsigned char message_type;
+    unsigned char version;
+    unsigned short length;
+    unsigned short sequence_id;
+};
+
+using view_header_zipped = zipped<net_uint<4>, mem<&view_header::transport>, net_uint<4>, mem<&view_header::message_type>,
+                                  net_uint8, mem<&view_header::version>, net_uint16, mem<&view_header::length>, reserved<8>,
+                                  net_uint16, mem<&view_header::sequence_id>>;
+
+GTEST_TEST(packet_view_test, single_field_get)
+{
+    alignas(8) unsigned char src[8] = {0x1b, 0x02, 0x00, 0x2c, 0x00, 0x12, 0x34, 0x00};
+    collect_logger log;
+
+    auto view = make_packet_view<view_header_zipped>(make_aligned_ptr<8>(src, &log));
+
+    // Only the accesses of the requested field are executed
+    EXPECT_EQ(view.get<&view_header::sequence_id>(), 0x1234);
+    EXPECT_EQ(log.size(), 1u);
+    log.clear();
+
+    EXPECT_EQ(view.get<&view_header::message_type>(), 0x0b);
+    EXPECT_EQ(view.get<&view_header::transport>(), 0x01);
+    EXPECT_EQ(view.get<&view_header::version>(), 0x02);
+    EXPECT_EQ(view.get<&view_header::length>(), 0x002c);
+    EXPECT_EQ(log.size(), 4u);
+}
+
+GTEST_TEST(packet_view_test, single_field_set)
+{
+    alignas(8) unsigned char buffer[8] = {0x1b, 0x02, 0x00, 0x2c, 0xff, 0x12, 0x34, 0xff};
+    collect_logger log;
+
+    auto view = make_packet_view<view_header_zipped>(make_aligned_ptr<8>(buffer, &log));
+
+    // Sub-byte field -> read-modify-write of the surrounding byte
+    view.set<&view_header::message_type>(0x5);
+    EXPECT_EQ(buffer[0], 0x15);
+    EXPECT_EQ(log.size(), 2u);
+    log.clear();
+
+    // Byte aligned field, the neighbouring reserved bytes are preserved
+    view.set<&view_header::sequence_id>(0xabcd);
+    EXPECT_EQ(buffer[4], 0xff);
+    EXPECT_EQ(buffer[5], 0xab);
+    EXPECT_EQ(buffer[6], 0xcd);
+    EXPECT_EQ(buffer[7], 0xff);
+    EXPECT_EQ(view.get<&view_header::sequence_id>(), 0xabcd);
+    EXPECT_EQ(view.get<&view_header::transport>(), 0x1);
+}
+
+struct short_view_header
+{
+    unsigned char flags;
+    unsigned short length;
+};
+
+using short_view_zipped = zipped<net_uint8, mem<&short_view_header::flags>, net_uint16, mem<&short_view_header::length>>;
+
+GTEST_TEST(packet_view_test, set_within_packet)
+{
+    alignas(4) unsigned char buffer[4] = {0x5a, 0x00, 0x00, 0xee};
+    collect_logger log;
+
+    auto view = make_packet_view<short_view_zipped>(make_aligned_ptr<4>(buffer, &log));
+
+    // No access may touch the byte behind the 3 byte packet, the logged offsets are relative to the field at byte 1
+    view.set<&short_view_header::length>(0xabcd);
+    for (size_t i = 0; i < log.size(); ++i)
+    {
+        EXPECT_GE(log[i].offset, 0);
+        EXPECT_LE(log[i].offset + int(log[i].size), 2);
+    }
+    EXPECT_EQ(buffer[0], 0x5a);
+    EXPECT_EQ(buffer[1], 0xab);
+    EXPECT_EQ(buffer[2], 0xcd);
+    EXPECT_EQ(buffer[3], 0xee);
+}
+
+struct le_view_header
+{
+    unsigned char flags;
+    unsigned int counter;
+};
+
+using le_view_zipped = zipped<net_uint8, mem<&le_view_header::flags>, int_<false, 32, byte_order::le>, mem<&le_view_header::counter>,
+                              reserved<24>>;
+
+GTEST_TEST(packet_view_test, little_endian_set)
+{
+    alignas(8) unsigned char buffer[8] = {0x5a, 0x00, 0x00, 0x00, 0x00, 0xff, 0xff, 0xff};
+
+    auto view = make_packet_view<le_view_zipped>(make_aligned_ptr<8>(buffer));
+
+    // The field straddles word boundaries, each part keeps the field's byte order
+    view.set<&le_view_header::counter>(0x04030201u);
+    EXPECT_EQ(buffer[0], 0x5a);
+    EXPECT_EQ(buffer[1], 0x01);
+    EXPECT_EQ(buffer[2], 0x02);
+    EXPECT_EQ(buffer[3], 0x03);
+    EXPECT_EQ(buffer[4], 0x04);
+    EXPECT_EQ(buffer[5], 0xff);
+    EXPECT_EQ(view.get<&le_view_header::counter>(), 0x04030201u);
+}
+
+struct mode_header
+{
+    enum class mode : unsigned char
+    {
+        idle = 1,
+        active = 2
+    };
+
+    unsigned char version;
+    mode state;
+};
+
+using mode_header_zipped = zipped<net_uint8, mem<&mode_header::version>, net_uint8, mem<&mode_header::state>>;
+
+GTEST_TEST(packet_view_test, enum_member)
+{
+    alignas(8) unsigned char buffer[2] = {0x02, 0x01};
+
+    auto view = make_packet_view<mode_header_zipped>(make_aligned_ptr<8>(buffer));
+    EXPECT_EQ(view.get<&mode_header::state>(), mode_header::mode::idle);
+
+    view.set<&mode_header::state>(mode_header::mode::active);
+    EXPECT_EQ(buffer[1], 0x02);
+    EXPECT_EQ(view.get<&mode_header::state>(), mode_header::mode::active);
+}
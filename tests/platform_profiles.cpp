@@ -0,0 +1,32 @@
+#define NETSER_TEST_PROFILE unaligned_little_endian
+#include "test_shared.hpp"
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+GTEST_TEST(platform_profiles_test, unaligned_wide_access)
+{
+    alignas(8) unsigned char buffer[16] = {};
+    unsigned long long value = 0x0102030405060708ull;
+    unsigned long long dest = 0;
+    collect_logger log;
+
+    using u64_layout = layout<net_uint<64>>;
+    using u64_mapping = mapping_list<identity>;
+
+    // The field starts one byte past an 8 byte boundary, the profile still allows a single 8 byte store and load
+    write<u64_layout, u64_mapping>(make_aligned_ptr<8, 1>(buffer + 1, &log), value);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 8);
+    EXPECT_EQ(buffer[1], 0x01);
+    EXPECT_EQ(buffer[8], 0x08);
+    log.clear();
+
+    read<u64_layout, u64_mapping>(make_aligned_ptr<8, 1>(buffer + 1, &log), dest);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 8);
+    EXPECT_EQ(dest, value);
+}
@@ -0,0 +1,79 @@
+#include "test_shared.hpp"
+#include <netser/projection.hpp>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct projected_header
+{
+    unsigned char transport;
+    unsigned char version;
+    unsigned short length;
+    unsigned int correction;
+};
+
+using projected_header_zipped = zipped<net_uint8, mem<&projected_header::transport>, net_uint8, mem<&projected_header::version>,
+                                       net_uint16, mem<&projected_header::length>, net_uint32, mem<&projected_header::correction>>;
+
+GTEST_TEST(projection_test, selected_members_only)
+{
+    alignas(8) unsigned char src[8] = {0x12, 0x02, 0x00, 0x2c, 0xde, 0xad, 0xbe, 0xef};
+    collect_logger log;
+
+    projected_header header{0xff, 0xff, 0xffff, 0xffffffff};
+    read_zipped_only<projected_header_zipped, &projected_header::transport, &projected_header::length>(make_aligned_ptr<8>(src, &log),
+                                                                                                      header);
+
+    EXPECT_EQ(header.transport, 0x12);
+    EXPECT_EQ(header.length, 0x002c);
+
+    // version is read along with the span but not stored, correction is not accessed at all
+    EXPECT_EQ(header.version, 0xff);
+    EXPECT_EQ(header.correction, 0xffffffffu);
+    EXPECT_EQ(log.size(), 1u);
+}
+
+GTEST_TEST(projection_test, trailing_member)
+{
+    alignas(8) unsigned char src[8] = {0x12, 0x02, 0x00, 0x2c, 0xde, 0xad, 0xbe, 0xef};
+    collect_logger log;
+
+    projected_header header{0xff, 0xff, 0xffff, 0};
+    read_zipped_only<projected_header_zipped, &projected_header::correction>(make_aligned_ptr<8>(src, &log), header);
+
+    EXPECT_EQ(header.correction, 0xdeadbeefu);
+    EXPECT_EQ(header.transport, 0xff);
+    EXPECT_EQ(header.length, 0xffff);
+    EXPECT_EQ(log.size(), 1u);
+}
+
+struct projected_status
+{
+    enum class mode : unsigned char
+    {
+        idle = 1,
+        active = 2
+    };
+
+    unsigned char version;
+    mode state;
+    unsigned short length;
+};
+
+using projected_status_zipped = zipped<net_uint8, mem<&projected_status::version>, net_uint8, mem<&projected_status::state>, net_uint16,
+                                       mem<&projected_status::length>>;
+
+projected_status_zipped default_zipped(projected_status);
+
+GTEST_TEST(projection_test, enum_member)
+{
+    alignas(8) unsigned char src[4] = {0x02, 0x02, 0x00, 0x2c};
+
+    projected_status status{0xff, projected_status::mode::idle, 0xffff};
+    read_only<&projected_status::state>(make_aligned_ptr<8>(src), status);
+
+    EXPECT_EQ(status.state, projected_status::mode::active);
+    EXPECT_EQ(status.version, 0xff);
+    EXPECT_EQ(status.length, 0xffff);
+}
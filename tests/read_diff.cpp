@@ -0,0 +1,85 @@
+#include "test_shared.hpp"
+#include <netser/read_diff.hpp>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct status_block
+{
+    unsigned char mode;
+    unsigned char level;
+    unsigned short position;
+    unsigned int counter;
+    unsigned char alarms[8];
+};
+
+using status_block_zipped
+    = zipped<net_uint<4>, mem<&status_block::mode>, net_uint<4>, mem<&status_block::level>, net_uint16, mem<&status_block::position>,
+             net_uint32, mem<&status_block::counter>, net_uint8[8], mem<&status_block::alarms>>;
+
+GTEST_TEST(read_diff_test, first_read_decodes_all)
+{
+    alignas(8) unsigned char buffer[16] = {0x39, 0x12, 0x34, 0xde, 0xad, 0xbe, 0xef, 1, 2, 3, 4, 5, 6, 7, 8};
+
+    shadow_image<status_block_zipped> shadow;
+    status_block status{};
+    const auto changed = read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow);
+
+    EXPECT_TRUE(changed.all());
+    EXPECT_EQ(status.mode, 3);
+    EXPECT_EQ(status.level, 9);
+    EXPECT_EQ(status.position, 0x1234);
+    EXPECT_EQ(status.counter, 0xdeadbeef);
+    EXPECT_EQ(status.alarms[7], 8);
+}
+
+GTEST_TEST(read_diff_test, reports_changed_members)
+{
+    alignas(8) unsigned char buffer[16] = {0x39, 0x12, 0x34, 0xde, 0xad, 0xbe, 0xef, 1, 2, 3, 4, 5, 6, 7, 8};
+
+    shadow_image<status_block_zipped> shadow;
+    status_block status{};
+    read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow);
+
+    EXPECT_TRUE(read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow).none());
+
+    // level shares its byte with mode
+    buffer[0] = 0x35;
+    buffer[6] = 0xee;
+    const auto changed = read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow);
+
+    EXPECT_EQ(changed, (make_dirty_mask<status_block_zipped, &status_block::level, &status_block::counter>()));
+    EXPECT_EQ(status.mode, 3);
+    EXPECT_EQ(status.level, 5);
+    EXPECT_EQ(status.counter, 0xdeadbeee);
+
+    buffer[9] = 7;
+    EXPECT_EQ(read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow),
+              (make_dirty_mask<status_block_zipped, &status_block::alarms>()));
+    EXPECT_EQ(status.alarms[2], 7);
+
+    EXPECT_TRUE(read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow).none());
+
+    shadow.reset();
+    EXPECT_TRUE(read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow).all());
+}
+
+GTEST_TEST(read_diff_test, decodes_changed_group_only)
+{
+    alignas(8) unsigned char buffer[16] = {0x39, 0x12, 0x34, 0xde, 0xad, 0xbe, 0xef, 1, 2, 3, 4, 5, 6, 7, 8};
+
+    shadow_image<status_block_zipped> shadow;
+    status_block status{};
+    read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow);
+
+    // mode, level, position and counter form one run of integers, only the counter is decoded again
+    status.mode = 0;
+    status.position = 0;
+    buffer[5] = 0xbf;
+    EXPECT_EQ(read_diff<status_block_zipped>(make_aligned_ptr<8>(buffer), status, shadow),
+              (make_dirty_mask<status_block_zipped, &status_block::counter>()));
+    EXPECT_EQ(status.counter, 0xdeadbfefu);
+    EXPECT_EQ(status.mode, 0);
+    EXPECT_EQ(status.position, 0);
+}
@@ -0,0 +1,42 @@
+#include "test_shared.hpp"
+#include <netser/record_stream.hpp>
+#include <array>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct record
+{
+    unsigned short a;
+    unsigned int b;
+};
+
+using record_zipped = zipped<net_uint16, mem<&record::a>, net_uint32, mem<&record::b>>;
+
+GTEST_TEST(record_stream_test, periodic_residues)
+{
+    // 6 byte records in a 4 aligned buffer: residues 0, 2, 0, 2, 0
+    std::array<record, 5> src;
+    for (size_t i = 0; i < src.size(); ++i)
+        src[i] = {static_cast<unsigned short>(0x100 + i), static_cast<unsigned int>(0x10000 * i + 7)};
+
+    alignas(4) unsigned char buffer[5 * 6] = {};
+    collect_logger log;
+
+    record_stream<record_zipped>::write(make_aligned_ptr<4>(buffer, &log), std::span<record>(src));
+    EXPECT_EQ(buffer[6 * 3 + 1], 0x03);
+    EXPECT_EQ(buffer[6 * 3 + 3], 0x03);
+    // Every record is written with one word and one dword, the gcd alignment of 2 would need three words
+    EXPECT_EQ(log.size(), 10u);
+    log.clear();
+
+    std::array<record, 5> dest{};
+    record_stream<record_zipped>::read(make_aligned_ptr<4>(buffer, &log), std::span<record>(dest));
+    EXPECT_EQ(log.size(), 10u);
+    for (size_t i = 0; i < dest.size(); ++i)
+    {
+        EXPECT_EQ(dest[i].a, src[i].a);
+        EXPECT_EQ(dest[i].b, src[i].b);
+    }
+}
@@ -0,0 +1,90 @@
+#include "test_shared.hpp"
+#include <netser/segments.hpp>
+#include <cstddef>
+#include <cstring>
+#include <span>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct segment_header
+{
+    unsigned char type;
+    unsigned short length;
+    unsigned int sequence;
+};
+
+using segment_header_zipped = zipped<net_uint8, mem<&segment_header::type>, net_uint16, mem<&segment_header::length>, net_uint32,
+                                     mem<&segment_header::sequence>>;
+
+namespace {
+
+    const std::byte segment_packet[7] = {std::byte{0x01}, std::byte{0x00}, std::byte{0x2c}, std::byte{0xde},
+                                         std::byte{0xad},  std::byte{0xbe}, std::byte{0xef}};
+
+}
+
+GTEST_TEST(segments_test, read_every_split)
+{
+    // The split falls in front of, behind or into each field
+    for (size_t split = 0; split <= sizeof(segment_packet); ++split)
+    {
+        alignas(8) std::byte first[8] = {};
+        alignas(8) std::byte second[8] = {};
+        std::memcpy(first, segment_packet, split);
+        std::memcpy(second, segment_packet + split, sizeof(segment_packet) - split);
+
+        const const_segment parts[] = {{first, split}, {second, sizeof(segment_packet) - split}};
+
+        segment_header header{};
+        auto result = read_segments<segment_header_zipped>(parts, header);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(*result, 7u);
+        EXPECT_EQ(header.type, 1);
+        EXPECT_EQ(header.length, 0x2c);
+        EXPECT_EQ(header.sequence, 0xdeadbeefu);
+    }
+}
+
+GTEST_TEST(segments_test, read_gathered)
+{
+    alignas(8) std::byte first[2], second[3], third[8];
+    std::memcpy(first, segment_packet, 2);
+    std::memcpy(second, segment_packet + 2, 3);
+    std::memcpy(third, segment_packet + 5, 2);
+
+    const const_segment parts[] = {{first, 2}, {second, 3}, {third, 2}};
+
+    segment_header header{};
+    auto result = read_segments<segment_header_zipped>(parts, header);
+    ASSERT_TRUE(result.has_value());
+    EXPECT_EQ(header.length, 0x2c);
+    EXPECT_EQ(header.sequence, 0xdeadbeefu);
+
+    result = read_segments<segment_header_zipped>(std::span<const const_segment>(parts, 2), header);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), span_error::too_short);
+}
+
+GTEST_TEST(segments_test, write_every_split)
+{
+    const segment_header header{0x01, 0x2c, 0xdeadbeef};
+
+    for (size_t split = 1; split < sizeof(segment_packet); ++split)
+    {
+        // Bytes behind the segments are never touched
+        alignas(8) std::byte first[8], second[8];
+        std::memset(first, 0xff, sizeof(first));
+        std::memset(second, 0xff, sizeof(second));
+
+        const mutable_segment parts[] = {{first, split}, {second, sizeof(segment_packet) - split}};
+
+        auto result = write_segments<segment_header_zipped>(parts, header);
+        ASSERT_TRUE(result.has_value());
+        EXPECT_EQ(std::memcmp(first, segment_packet, split), 0);
+        EXPECT_EQ(std::memcmp(second, segment_packet + split, sizeof(segment_packet) - split), 0);
+        EXPECT_EQ(first[split], std::byte{0xff});
+        EXPECT_EQ(second[sizeof(segment_packet) - split], std::byte{0xff});
+    }
+}
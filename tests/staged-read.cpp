@@ -0,0 +1,80 @@
+#define NETSER_STAGED_READS
+#include "test_shared.hpp"
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct header_struct
+{
+    unsigned char a;
+    unsigned char b;
+    unsigned short c;
+    unsigned int d;
+    unsigned long long e;
+    unsigned short f;
+};
+
+GTEST_TEST(staged_read_test, small_layout)
+{
+    alignas(8) unsigned char src[1 + 18];
+    for (size_t i = 0; i < sizeof(src); ++i)
+        src[i] = static_cast<unsigned char>(i);
+
+    header_struct dest{};
+    collect_logger log;
+
+    using header_layout = layout<net_uint8, net_uint8, net_uint16, net_uint32, net_uint<64>, net_uint16>;
+    using header_mapping = mapping_list<mem<&header_struct::a>, mem<&header_struct::b>, mem<&header_struct::c>, mem<&header_struct::d>,
+                                        mem<&header_struct::e>, mem<&header_struct::f>>;
+
+    static_assert(layout_size_v<header_layout> == 18 * 8);
+
+    // Unaligned source -> a single bulk copy
+    read<header_layout, header_mapping>(make_aligned_ptr<1, 0>(src + 1, &log), dest);
+    EXPECT_EQ(dest.a, 0x01);
+    EXPECT_EQ(dest.b, 0x02);
+    EXPECT_EQ(dest.c, 0x0304);
+    EXPECT_EQ(dest.d, 0x05060708u);
+    EXPECT_EQ(dest.e, 0x090a0b0c0d0e0f10ull);
+    EXPECT_EQ(dest.f, 0x1112);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].offset, 0);
+    EXPECT_EQ(log[0].size, 18);
+    log.clear();
+
+    // Source aligned for the widest access -> the usual span plan
+    header_struct aligned_dest{};
+    read<header_layout, header_mapping>(make_aligned_ptr<8, 0>(src, &log), aligned_dest);
+    EXPECT_EQ(aligned_dest.e, 0x08090a0b0c0d0e0full);
+    EXPECT_GT(log.size(), 1u);
+}
+
+using header_zipped = zipped<net_uint8, mem<&header_struct::a>, net_uint8, mem<&header_struct::b>, net_uint16, mem<&header_struct::c>,
+                             net_uint32, mem<&header_struct::d>, net_uint<64>, mem<&header_struct::e>, net_uint16, mem<&header_struct::f>>;
+
+header_zipped default_zipped(header_struct &);
+
+GTEST_TEST(staged_read_test, zipped_entry_points)
+{
+    alignas(8) unsigned char src[1 + 18];
+    for (size_t i = 0; i < sizeof(src); ++i)
+        src[i] = static_cast<unsigned char>(i);
+
+    collect_logger log;
+
+    header_struct zipped_dest{};
+    read_zipped<header_zipped>(make_aligned_ptr<1, 0>(src + 1, &log), zipped_dest);
+    EXPECT_EQ(zipped_dest.d, 0x05060708u);
+    EXPECT_EQ(zipped_dest.f, 0x1112);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].size, 18);
+    log.clear();
+
+    header_struct operator_dest{};
+    auto end = make_aligned_ptr<1, 0>(src + 1, &log) >> operator_dest;
+    EXPECT_EQ(end.get(), src + 19);
+    EXPECT_EQ(operator_dest.e, 0x090a0b0c0d0e0f10ull);
+    ASSERT_EQ(log.size(), 1);
+    EXPECT_EQ(log[0].size, 18);
+}
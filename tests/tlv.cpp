@@ -0,0 +1,97 @@
+#include "test_shared.hpp"
+#include <netser/tlv.hpp>
+#include <iterator>
+#include <vector>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct path_entry
+{
+    unsigned short first;
+    unsigned short second;
+};
+
+using path_entry_zipped = zipped<net_uint16, mem<&path_entry::first>, net_uint16, mem<&path_entry::second>>;
+
+path_entry_zipped default_zipped(path_entry);
+
+GTEST_TEST(tlv_test, walk_records)
+{
+    alignas(8) unsigned char tlvs[] = {
+        0x00, 0x08, 0x00, 0x04, 0x00, 0x01, 0x00, 0x02, // path trace, 4 bytes
+        0x00, 0x03, 0x00, 0x02, 0xab, 0xcd,             // 2 bytes
+        0x00, 0x01, 0x00, 0x10, 0x00, 0x00              // length exceeds the buffer
+    };
+
+    std::vector<size_t> types;
+    path_entry entry{};
+
+    auto range = make_tlv_range<ptp_tlv>(make_aligned_ptr<8>(tlvs), sizeof(tlvs));
+    for (auto record : range)
+    {
+        types.push_back(record.type);
+        if (record.type == 0x8)
+        {
+            EXPECT_EQ(record.length, 4u);
+            EXPECT_EQ(record.payload.get(), tlvs + 4);
+            EXPECT_EQ(*(record >> entry), 4u);
+        }
+        else
+        {
+            EXPECT_EQ(record.length, 2u);
+            EXPECT_EQ(record.payload.get(), tlvs + 12);
+        }
+    }
+
+    ASSERT_EQ(types.size(), 2u);
+    EXPECT_EQ(types[0], 0x8u);
+    EXPECT_EQ(types[1], 0x3u);
+    EXPECT_EQ(entry.first, 1);
+    EXPECT_EQ(entry.second, 2);
+
+    // Even lengths keep the payloads 2 byte aligned
+    using payload_pointer = decltype((*range.begin()).payload);
+    EXPECT_EQ(std::remove_const_t<payload_pointer>::get_max_alignment(), 2u);
+}
+
+GTEST_TEST(tlv_test, short_record)
+{
+    // The last record is too short for a path entry
+    alignas(8) unsigned char tlvs[] = {0x00, 0x08, 0x00, 0x02, 0x00, 0x01};
+    collect_logger log;
+
+    size_t records = 0;
+    path_entry entry{7, 7};
+    for (auto record : make_tlv_range<ptp_tlv>(make_aligned_ptr<8>(tlvs, &log), sizeof(tlvs)))
+    {
+        ++records;
+        log.clear();
+
+        const auto result = record >> entry;
+        ASSERT_FALSE(result.has_value());
+        EXPECT_EQ(result.error(), span_error::too_short);
+        EXPECT_EQ(log.size(), 0u);
+    }
+
+    EXPECT_EQ(records, 1u);
+    EXPECT_EQ(entry.first, 7);
+    EXPECT_EQ(entry.second, 7);
+}
+
+GTEST_TEST(tlv_test, forward_iterator)
+{
+    alignas(8) unsigned char tlvs[] = {0x00, 0x08, 0x00, 0x02, 0x00, 0x01, 0x00, 0x03, 0x00, 0x00};
+
+    auto range = make_tlv_range<ptp_tlv>(make_aligned_ptr<8>(tlvs), sizeof(tlvs));
+    static_assert(std::forward_iterator<decltype(range.begin())>);
+
+    auto first = range.begin();
+    auto second = std::next(first);
+    EXPECT_NE(first, second);
+    EXPECT_EQ(std::next(first), second);
+    EXPECT_EQ((*second).type, 0x3u);
+    EXPECT_EQ(std::next(second), decltype(first)());
+    EXPECT_EQ(std::distance(range.begin(), decltype(first)()), 2);
+}
@@ -0,0 +1,74 @@
+#include "test_shared.hpp"
+#include <netser/validate.hpp>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct announce_body
+{
+    enum class time_source : unsigned char
+    {
+        atomic_clock = 0x10,
+        gps = 0x20,
+        ntp = 0x50,
+        internal_oscillator = 0xa0
+    };
+
+    unsigned char priority;
+    unsigned short steps_removed;
+    time_source source;
+};
+
+using announce_body_zipped
+    = zipped<net_uint8, mem<&announce_body::priority>, reserved<8>, net_uint16,
+             constrained<mem<&announce_body::steps_removed>, in_range<0, 255>>, net_uint8,
+             constrained<mem<&announce_body::source>, enum_values<announce_body::time_source::atomic_clock, announce_body::time_source::gps,
+                                                                  announce_body::time_source::ntp,
+                                                                  announce_body::time_source::internal_oscillator>>>;
+
+GTEST_TEST(validate_test, valid_packet)
+{
+    alignas(8) unsigned char packet[8] = {0x80, 0x00, 0x00, 0x02, 0x20};
+
+    announce_body body{};
+    EXPECT_EQ(read_validated<announce_body_zipped>(make_aligned_ptr<8>(packet), body), 0u);
+    EXPECT_EQ(body.priority, 0x80);
+    EXPECT_EQ(body.steps_removed, 2);
+    EXPECT_EQ(body.source, announce_body::time_source::gps);
+
+    // Plain reads of the same zipped are not affected by the constraints
+    announce_body plain{};
+    read_zipped<announce_body_zipped>(make_aligned_ptr<8>(packet), plain);
+    EXPECT_EQ(plain.source, announce_body::time_source::gps);
+}
+
+GTEST_TEST(validate_test, error_mask)
+{
+    alignas(8) unsigned char packet[8] = {0x80, 0x01, 0x00, 0x02, 0x20};
+
+    announce_body body{};
+    EXPECT_EQ(read_validated<announce_body_zipped>(make_aligned_ptr<8>(packet), body), validation_errors(reserved_bits_set));
+
+    packet[1] = 0x00;
+    packet[2] = 0x01;
+    packet[4] = 0x21;
+    EXPECT_EQ(read_validated<announce_body_zipped>(make_aligned_ptr<8>(packet), body),
+              validation_errors(value_out_of_range | invalid_enum_value));
+
+    // Fields are filled in even if invalid
+    EXPECT_EQ(body.steps_removed, 0x102);
+}
+
+GTEST_TEST(validate_test, enum_member_roundtrip)
+{
+    const announce_body src{0x7f, 3, announce_body::time_source::ntp};
+
+    alignas(8) unsigned char packet[8] = {};
+    write_zipped<announce_body_zipped>(make_aligned_ptr<8>(packet), src);
+    EXPECT_EQ(packet[4], 0x50);
+
+    announce_body dest{};
+    EXPECT_EQ(read_validated<announce_body_zipped>(make_aligned_ptr<8>(packet), dest), 0u);
+    EXPECT_EQ(dest.source, announce_body::time_source::ntp);
+}
@@ -0,0 +1,84 @@
+#include "test_shared.hpp"
+#include <netser/variant_layout.hpp>
+#include <variant>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct message_header
+{
+    unsigned char message_type;
+    unsigned char version;
+    unsigned short length;
+};
+
+using message_header_zipped = zipped<net_uint8, mem<&message_header::message_type>, net_uint8, mem<&message_header::version>, net_uint16,
+                                     mem<&message_header::length>>;
+
+struct sync_body
+{
+    unsigned int seconds;
+    unsigned int nanoseconds;
+};
+
+using sync_body_zipped = zipped<net_uint32, mem<&sync_body::seconds>, net_uint32, mem<&sync_body::nanoseconds>>;
+
+struct announce_body
+{
+    unsigned short steps_removed;
+    unsigned char priority;
+};
+
+using announce_body_zipped = zipped<net_uint16, mem<&announce_body::steps_removed>, net_uint8, mem<&announce_body::priority>>;
+
+using test_message = variant_layout<discriminator<message_header_zipped, &message_header::message_type>,
+                                    variant_case<0x0, sync_body, sync_body_zipped>, variant_case<0xb, announce_body, announce_body_zipped>>;
+
+GTEST_TEST(variant_layout_test, read_into_variant)
+{
+    alignas(8) unsigned char sync[16] = {0x00, 0x02, 0x00, 0x0c, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x2a};
+    alignas(8) unsigned char announce[16] = {0x0b, 0x02, 0x00, 0x07, 0x00, 0x03, 0x80};
+    alignas(8) unsigned char unknown[16] = {0x05, 0x02, 0x00, 0x04};
+
+    message_header header{};
+    test_message::variant_type body;
+
+    ASSERT_TRUE(test_message::read(make_aligned_ptr<8>(sync), header, body));
+    ASSERT_EQ(body.index(), 0u);
+    EXPECT_EQ(std::get<sync_body>(body).seconds, 0x100u);
+    EXPECT_EQ(std::get<sync_body>(body).nanoseconds, 42u);
+
+    ASSERT_TRUE(test_message::read(make_aligned_ptr<8>(announce), header, body));
+    ASSERT_EQ(body.index(), 1u);
+    EXPECT_EQ(std::get<announce_body>(body).steps_removed, 3);
+    EXPECT_EQ(std::get<announce_body>(body).priority, 0x80);
+
+    // Unknown message types only decode the header
+    EXPECT_FALSE(test_message::read(make_aligned_ptr<8>(unknown), header, body));
+    EXPECT_EQ(header.message_type, 0x05);
+    EXPECT_EQ(body.index(), 1u);
+}
+
+GTEST_TEST(variant_layout_test, dispatch_to_handler)
+{
+    alignas(8) unsigned char announce[16] = {0x0b, 0x02, 0x00, 0x07, 0x00, 0x03, 0x80};
+
+    int calls = 0;
+    message_header header{};
+    const bool known = test_message::dispatch(make_aligned_ptr<8>(announce), header, [&](const message_header &hdr, const auto &body) {
+        ++calls;
+        EXPECT_EQ(hdr.length, 7);
+        if constexpr (std::is_same_v<std::remove_cvref_t<decltype(body)>, announce_body>)
+        {
+            EXPECT_EQ(body.steps_removed, 3);
+        }
+        else
+        {
+            ADD_FAILURE() << "Wrong body type";
+        }
+    });
+
+    EXPECT_TRUE(known);
+    EXPECT_EQ(calls, 1);
+}
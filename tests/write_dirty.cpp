@@ -0,0 +1,102 @@
+#include "test_shared.hpp"
+#include <netser/write_dirty.hpp>
+#include <cstring>
+#include <gtest/gtest.h>
+
+
+using namespace netser;
+
+struct replicated_state
+{
+    unsigned char mode;
+    unsigned char level;
+    unsigned short position;
+    unsigned int counter;
+    unsigned char flags[8];
+};
+
+using replicated_state_zipped
+    = zipped<net_uint<4>, mem<&replicated_state::mode>, net_uint<4>, mem<&replicated_state::level>, net_uint16,
+             mem<&replicated_state::position>, net_uint32, mem<&replicated_state::counter>, net_uint8[8], mem<&replicated_state::flags>>;
+
+GTEST_TEST(write_dirty_test, mask_bits)
+{
+    const auto mask = make_dirty_mask<replicated_state_zipped, &replicated_state::level, &replicated_state::counter>();
+    EXPECT_EQ(mask.size(), 5u);
+    EXPECT_FALSE(mask[0]);
+    EXPECT_TRUE(mask[1]);
+    EXPECT_TRUE(mask[3]);
+    EXPECT_EQ(mask.count(), 2u);
+}
+
+GTEST_TEST(write_dirty_test, dirty_fields_only)
+{
+    replicated_state state{3, 5, 0x1234, 0xdeadbeef, {1, 2, 3, 4, 5, 6, 7, 8}};
+
+    alignas(8) unsigned char buffer[16] = {};
+    write_zipped<replicated_state_zipped>(make_aligned_ptr<8>(buffer), state);
+
+    // level shares its byte with mode, counter is a whole run
+    state.level = 9;
+    state.counter = 0xcafef00d;
+    state.position = 0x4321; // changed but not marked
+    write_dirty<replicated_state_zipped>(make_aligned_ptr<8>(buffer), state,
+                                         make_dirty_mask<replicated_state_zipped, &replicated_state::level, &replicated_state::counter>());
+
+    EXPECT_EQ(buffer[0], 0x39);
+    EXPECT_EQ(buffer[1], 0x12);
+    EXPECT_EQ(buffer[2], 0x34);
+    EXPECT_EQ(buffer[3], 0xca);
+    EXPECT_EQ(buffer[6], 0x0d);
+
+    state.flags[2] = 7;
+    write_dirty<replicated_state_zipped>(make_aligned_ptr<8>(buffer), state,
+                                         make_dirty_mask<replicated_state_zipped, &replicated_state::position, &replicated_state::flags>());
+
+    alignas(8) unsigned char expected[16] = {};
+    write_zipped<replicated_state_zipped>(make_aligned_ptr<8>(expected), state);
+    EXPECT_EQ(std::memcmp(buffer, expected, sizeof(buffer)), 0);
+}
+
+struct channel_levels
+{
+    unsigned char a, b, c, d, e, f, g, h;
+};
+
+using channel_levels_zipped
+    = zipped<net_uint8, mem<&channel_levels::a>, net_uint8, mem<&channel_levels::b>, net_uint8, mem<&channel_levels::c>, net_uint8,
+             mem<&channel_levels::d>, net_uint8, mem<&channel_levels::e>, net_uint8, mem<&channel_levels::f>, net_uint8,
+             mem<&channel_levels::g>, net_uint8, mem<&channel_levels::h>>;
+
+GTEST_TEST(write_dirty_test, store_spans)
+{
+    channel_levels levels{1, 2, 3, 4, 5, 6, 7, 8};
+    collect_logger log;
+
+    alignas(8) unsigned char buffer[8] = {};
+    write_zipped<channel_levels_zipped>(make_aligned_ptr<8>(buffer, &log), levels);
+    ASSERT_EQ(log.size(), 1u);
+    log.clear();
+
+    // Seven dirty bytes share the store of write_zipped with a clean one, so the dirty bytes are merged into it
+    levels = {11, 12, 13, 14, 99, 16, 17, 18};
+    auto mask = make_dirty_mask<channel_levels_zipped, &channel_levels::a, &channel_levels::b, &channel_levels::c, &channel_levels::d,
+                                &channel_levels::f, &channel_levels::g, &channel_levels::h>();
+    write_dirty<channel_levels_zipped>(make_aligned_ptr<8>(buffer, &log), levels, mask);
+
+    const unsigned char expected[8] = {11, 12, 13, 14, 5, 16, 17, 18};
+    EXPECT_EQ(std::memcmp(buffer, expected, sizeof(buffer)), 0);
+    ASSERT_EQ(log.size(), 2u);
+    EXPECT_EQ(log[1].size, 8u);
+    log.clear();
+
+    // Only clean stores are skipped, a 4 aligned buffer has two of them
+    alignas(8) unsigned char shifted[12] = {};
+    write_zipped<channel_levels_zipped>(make_aligned_ptr<4>(shifted + 4), levels);
+    levels.h = 28;
+    write_dirty<channel_levels_zipped>(make_aligned_ptr<4>(shifted + 4, &log), levels,
+                                       make_dirty_mask<channel_levels_zipped, &channel_levels::h>());
+    EXPECT_EQ(shifted[11], 28);
+    EXPECT_EQ(shifted[8], 99);
+    EXPECT_EQ(log.size(), 2u);
+}